@@ -24,6 +24,8 @@
 #include "apl/common.h"
 #include "apl/time/timers.h"
 #include "apl/utils/counter.h"
+#include "apl/utils/intrusivelist.h"
+#include "apl/utils/smallfunction.h"
 #include "apl/utils/streamer.h"
 #include "apl/utils/userdata.h"
 #include "apl/primitives/rect.h"
@@ -35,9 +37,10 @@ class ActionRef;
 
 using ActionList = std::vector<ActionPtr>;
 
-using StartFunc = std::function< void(ActionRef) >;
-using ThenFunc  = std::function< void(const ActionPtr&) >;
-using TerminateFunc = std::function< void(const TimersPtr&) >;
+// Callbacks are stored inline in the action, so capturing a weak pointer does not allocate
+using StartFunc = SmallFunction< void(ActionRef) >;
+using ThenFunc  = SmallFunction< void(const ActionPtr&) >;
+using TerminateFunc = SmallFunction< void(const TimersPtr&) >;
 
 union ActionResolveArg {
     int arg;
@@ -45,9 +48,13 @@ union ActionResolveArg {
 };
 
 /**
- * Common base class of action contracts.
+ * Common base class of action contracts.  Actions are allocated from a per-thread pool (see
+ * makePooled()); subclasses should be created the same way.
  */
-class Action : public std::enable_shared_from_this<Action>, private Counter<Action>, public UserData {
+class Action : public std::enable_shared_from_this<Action>,
+               private Counter<Action>,
+               public UserData,
+               public IntrusiveListHook<Action> {
 
 public:
     /**
@@ -98,6 +105,25 @@ public:
                                    apl_duration_t duration,
                                    Timers::Animator animator);
 
+    /**
+     * Make an action that animates component properties along an easing curve.  The properties
+     * are advanced by the timers together with every other batched animation and reach their
+     * final values when the duration elapses.  See Timers::setAnimation().
+     * @param timers
+     * @param duration The duration of the animation.  Must be positive.
+     * @param target The component being animated.
+     * @param properties The animated properties.
+     * @param easing The easing curve.
+     * @param reversed If true, the properties run from their end values to their start values.
+     * @return The animation action, or nullptr if the timers do not batch animations.
+     */
+    static ActionPtr makeAnimation(const TimersPtr& timers,
+                                   apl_duration_t duration,
+                                   const CoreComponentPtr& target,
+                                   const std::vector<std::unique_ptr<AnimatedProperty>>& properties,
+                                   const Easing& easing,
+                                   bool reversed);
+
 public:
     Action(const TimersPtr& timers, TerminateFunc terminate = nullptr);
     ~Action();
@@ -184,7 +210,8 @@ private:
     enum class ActionState { PENDING, RESOLVED, TERMINATED };
     ActionState mState;
     ThenFunc mThen;
-    std::vector<TerminateFunc> mTerminate;
+    TerminateFunc mTerminate;    // Most actions have at most one terminate callback
+    std::vector<TerminateFunc> mMoreTerminate;
     timeout_id mTimeoutId;
     const TimersPtr mTimers;
     ActionResolveArg mArgument;
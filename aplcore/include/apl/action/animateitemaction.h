@@ -44,6 +44,7 @@ public:
 private:
     void start();
     void advance();
+    void offload();
     void finalize();
 
 private:
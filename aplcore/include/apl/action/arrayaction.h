@@ -19,6 +19,7 @@
 #include "apl/action/action.h"
 #include "apl/command/command.h"
 #include "apl/command/arraycommand.h"
+#include "apl/utils/pool.h"
 
 namespace apl {
 
@@ -27,7 +28,7 @@ public:
     static std::shared_ptr<ArrayAction> make(const TimersPtr& timers,
                                              std::shared_ptr<const ArrayCommand> command,
                                              bool fastMode) {
-        auto ptr = std::make_shared<ArrayAction>(timers, command, fastMode);
+        auto ptr = makePooled<ArrayAction>(timers, command, fastMode);
         ptr->advance();
         return ptr;
     }
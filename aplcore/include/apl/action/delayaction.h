@@ -18,6 +18,7 @@
 
 #include "apl/action/action.h"
 #include "apl/command/command.h"
+#include "apl/utils/pool.h"
 
 namespace apl {
 
@@ -33,13 +34,13 @@ public:
             return nullptr;
 
         command->prepare();
-        auto ptr = std::make_shared<DelayAction>(timers, command, fastMode);
+        auto ptr = makePooled<DelayAction>(timers, command, fastMode);
         ptr->start();
         return ptr;
     }
 
     /**
-     * Build the delay action. You must use std::make_shared<>
+     * Build the delay action. You must use makePooled<> or std::make_shared<>
      * @param command The command to execute.
      * @param fastMode True if in fast mode.
      */
@@ -18,6 +18,7 @@
 
 #include "apl/action/action.h"
 #include "apl/command/corecommand.h"
+#include "apl/utils/pool.h"
 
 namespace apl {
 
@@ -25,7 +26,7 @@ class SequentialAction : public Action {
 public:
     static std::shared_ptr<SequentialAction> make(const TimersPtr& timers,
                                                   std::shared_ptr<const CoreCommand> command, bool fastMode) {
-        auto ptr = std::make_shared<SequentialAction>(timers, command, fastMode);
+        auto ptr = makePooled<SequentialAction>(timers, command, fastMode);
         ptr->advance();
         return ptr;
     }
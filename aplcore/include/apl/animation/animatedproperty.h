@@ -22,6 +22,7 @@
 
 namespace apl {
 
+class AnimationBatch;
 class CoreComponent;
 class Context;
 
@@ -33,6 +34,17 @@ public:
                                                     const Object& object);
 
     virtual void update(const CoreComponentPtr& component, float alpha) = 0;
+
+    /**
+     * Add this property to the animation being added to a batch of running animations.
+     * @param batch The batch.
+     */
+    virtual void addTo(AnimationBatch& batch) const = 0;
+
+    /**
+     * @return A description of this animation suitable for running it in the view host.
+     */
+    virtual Object describe() const = 0;
 };
 
 class AnimatedDouble : public AnimatedProperty {
@@ -41,6 +53,8 @@ public:
     AnimatedDouble(PropertyKey key, const CoreComponentPtr& component, double to);
 
     void update(const CoreComponentPtr& component, float alpha) override;
+    void addTo(AnimationBatch& batch) const override;
+    Object describe() const override;
 
 private:
     PropertyKey mKey;  // The component property we're animating
@@ -52,6 +66,18 @@ class AnimatedTransform : public AnimatedProperty {
 public:
     AnimatedTransform(const std::shared_ptr<InterpolatedTransformation>& transformation);
     void update(const CoreComponentPtr& component, float alpha) override;
+    void addTo(AnimationBatch& batch) const override;
+    Object describe() const override;
+
+    /**
+     * Interpolate a transformation and assign it to a component.
+     * @param component The component.
+     * @param transformation The transformation.
+     * @param alpha The eased alpha value.
+     */
+    static void apply(const CoreComponentPtr& component,
+                      const std::shared_ptr<InterpolatedTransformation>& transformation,
+                      float alpha);
 
 private:
     std::shared_ptr<InterpolatedTransformation> mTransformation;
@@ -0,0 +1,168 @@
+/**
+ * Copyright 2019 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef _APL_ANIMATION_BATCH_H
+#define _APL_ANIMATION_BATCH_H
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "apl/common.h"
+#include "apl/animation/easing.h"
+#include "apl/component/componentproperties.h"
+
+namespace apl {
+
+class AnimatedProperty;
+class InterpolatedTransformation;
+
+/**
+ * The animated component properties that are currently running, stored as structure-of-arrays.
+ *
+ * Each animated property is a track.  Tracks are grouped by property type, and every type keeps
+ * contiguous arrays of start time, duration, direction, easing curve, target component, and the
+ * values being interpolated.  A tick computes the alpha of every track in one pass, evaluates
+ * each run of tracks that share an easing curve with one batched call, interpolates the values
+ * in another pass, and finally applies the values to their components in a single sweep.
+ *
+ * The tracks of one animation are identified by the timeout id of that animation.  Removing
+ * an animation only marks its tracks; they are compacted out at the start of the next tick.
+ */
+class AnimationBatch {
+public:
+    /**
+     * Add the tracks of an animation.
+     * @param id The timeout id of the animation.
+     * @param start The start time of the animation.
+     * @param duration The duration of the animation.  Must be positive.
+     * @param easing The easing curve.
+     * @param reversed If true, the tracks run from their end values to their start values.
+     * @param target The component being animated.
+     * @param properties The animated properties.
+     */
+    void add(timeout_id id,
+             apl_time_t start,
+             apl_duration_t duration,
+             const Easing& easing,
+             bool reversed,
+             const CoreComponentPtr& target,
+             const std::vector<std::unique_ptr<AnimatedProperty>>& properties);
+
+    /**
+     * Add a numeric property track to the animation being added.  Called by AnimatedProperty.
+     * @param key The component property.
+     * @param from The value at the start of the animation.
+     * @param to The value at the end of the animation.
+     */
+    void addDouble(PropertyKey key, double from, double to);
+
+    /**
+     * Add a transform track to the animation being added.  Called by AnimatedProperty.
+     * @param transformation The interpolated transformation.
+     */
+    void addTransform(const std::shared_ptr<InterpolatedTransformation>& transformation);
+
+    /**
+     * Remove the tracks of an animation without applying any values.
+     * @param id The timeout id of the animation.
+     * @return True if the animation was found.
+     */
+    bool remove(timeout_id id);
+
+    /**
+     * Apply the final values of an animation and remove its tracks.
+     * @param id The timeout id of the animation.
+     */
+    void finish(timeout_id id);
+
+    /**
+     * Advance every running track to the given time.
+     * @param time The current time.
+     */
+    void tick(apl_time_t time);
+
+    /**
+     * @return True if no animations are running.
+     */
+    bool empty() const { return mAnimations.empty(); }
+
+    /**
+     * @return The number of running animations.
+     */
+    size_t size() const { return mAnimations.size(); }
+
+private:
+    // The arrays shared by every track type
+    struct Tracks {
+        std::vector<timeout_id> id;    // Zero for a removed track
+        std::vector<apl_time_t> start;
+        std::vector<float> duration;
+        std::vector<uint8_t> reversed;
+        std::vector<uint32_t> easing;   // Index into mEasings
+        std::vector<std::weak_ptr<CoreComponent>> target;
+        std::vector<float> alpha;       // Scratch space reused on every tick
+        std::vector<float> eased;       // Scratch space reused on every tick
+
+        size_t size() const { return id.size(); }
+        void push(timeout_id id, apl_time_t start, float duration, bool reversed, uint32_t easing,
+                  const CoreComponentPtr& target);
+        void move(size_t from, size_t to);
+        void resize(size_t size);
+    };
+
+    struct DoubleTracks : public Tracks {
+        std::vector<PropertyKey> key;
+        std::vector<double> from;
+        std::vector<double> to;
+        std::vector<double> value;      // Scratch space reused on every tick
+    };
+
+    struct TransformTracks : public Tracks {
+        std::vector<std::shared_ptr<InterpolatedTransformation>> transformation;
+    };
+
+    // The location of the tracks of one animation
+    struct Animation {
+        size_t doubleOffset;
+        size_t doubleCount;
+        size_t transformOffset;
+        size_t transformCount;
+    };
+
+    uint32_t easingIndex(const Easing& easing);
+    void ease(Tracks& tracks, size_t count, apl_time_t time);
+    void compact();
+    void applyDouble(size_t index);
+    void applyTransform(size_t index);
+
+    DoubleTracks mDoubles;
+    TransformTracks mTransforms;
+    std::unordered_map<timeout_id, Animation> mAnimations;
+    std::vector<Easing> mEasings;
+    size_t mRemoved = 0;
+
+    // The animation currently being added
+    timeout_id mAddId = 0;
+    apl_time_t mAddStart = 0;
+    float mAddDuration = 0;
+    bool mAddReversed = false;
+    uint32_t mAddEasing = 0;
+    CoreComponentPtr mAddTarget;
+};
+
+} // namespace apl
+
+#endif //_APL_ANIMATION_BATCH_H
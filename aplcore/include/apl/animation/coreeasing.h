@@ -19,6 +19,7 @@
 #include <vector>
 #include <array>
 #include <cmath>
+#include <algorithm>
 
 #include "apl/animation/easing.h"
 
@@ -34,12 +35,25 @@ public:
     virtual float calc(float t) const = 0;
     virtual bool equal(const EasingCurve* rhs) const = 0;
     virtual std::string toDebugString() const = 0;
+
+    /**
+     * Evaluate the easing curve at a number of times.
+     * @param t The array of times
+     * @param out The array to store the results in.  It may be the same as t.
+     * @param n The number of values to evaluate.
+     */
+    virtual void calc(const float *t, float *out, size_t n) const {
+        for (size_t i = 0 ; i < n ; i++)
+            out[i] = calc(t[i]);
+    }
 };
 /**
  * Linear easing curve.
  */
 class LinearEasing : public EasingCurve {
 public:
+    using EasingCurve::calc;
+
     float calc(float t) const override {
         if (t < 0) return 0;
         if (t > 1) return 1;
@@ -62,6 +76,8 @@ public:
  */
 class PathEasing : public EasingCurve {
 public:
+    using EasingCurve::calc;
+
     // We assume that the endpoints are provided and the x-values are correctly ordered and distinct
     PathEasing(std::vector<float>&& points)
         : mPoints(std::move(points))
@@ -76,17 +92,17 @@ public:
 
         while (left < right - 1) {
             auto mid = (left + right) / 2;
-            if (t < mPoints.at(mid * 2))
+            if (t < mPoints[mid * 2])
                 right = mid;
             else
                 left = mid;
         }
 
         left *= 2;
-        float t1 = mPoints.at(left);
-        float t2 = mPoints.at(left + 2);
-        float v1 = mPoints.at(left + 1);
-        float v2 = mPoints.at(left + 3);
+        float t1 = mPoints[left];
+        float t2 = mPoints[left + 2];
+        float v1 = mPoints[left + 1];
+        float v2 = mPoints[left + 3];
 
         return v1 + (v2 - v1) * (t - t1) / (t2 - t1);
     }
@@ -108,37 +124,42 @@ private:
 };
 
 
+/**
+ * Cubic bezier easing curve from (0,0) to (1,1) with control points (a,b) and (c,d).
+ *
+ * The curve is sampled at construction time.  Evaluating the curve finds the sample interval
+ * containing the time, interpolates an initial guess for the curve parameter, and refines it
+ * with Newton-Raphson iteration.  Bisection is used in the flat parts of the curve where
+ * Newton-Raphson converges poorly.
+ */
 class CubicBezierEasing : public EasingCurve {
 public:
     CubicBezierEasing(float a, float b, float c, float d)
         : mA(a), mB(b), mC(c), mD(d)
-    {}
+    {
+        for (int i = 0 ; i < SAMPLE_TABLE_SIZE ; i++)
+            mSamples[i] = f(mA, mC, i * SAMPLE_STEP);
+    }
 
     static inline float f(float a, float b, float t) {
         //return 3*a*(1-t)*(1-t)*t + 3*b*(1-t)*t*t + t*t*t;
         return t*(3*(1-t)*(a*(1-t)+b*t) + t*t);
     }
 
+    // Derivative of f() with respect to t
+    static inline float slope(float a, float b, float t) {
+        return 3*(1-t)*(1-t)*a + 6*(1-t)*t*(b-a) + 3*t*t*(1-b);
+    }
+
     float calc(float t) const override {
         if (t <= 0) return 0;
         if (t >= 1) return 1;
+        return f(mB, mD, solve(t));
+    }
 
-        float left = 0;
-        float right = 1;
-
-        while (left < right) {
-            float mid = (left + right) / 2;
-            float t_estimate = f(mA, mC, mid);
-            if (std::fabs(t - t_estimate) < 0.00001)
-                return f(mB, mD, mid);
-
-            if (t_estimate < t)
-                left = mid;
-            else
-                right = mid;
-        }
-        // This should never be reached.
-        return f(mB, mD, left);
+    void calc(const float *t, float *out, size_t n) const override {
+        for (size_t i = 0 ; i < n ; i++)
+            out[i] = CubicBezierEasing::calc(t[i]);
     }
 
     bool equal(const EasingCurve* rhs) const override {
@@ -151,7 +172,58 @@ public:
     }
 
 private:
+    static const int SAMPLE_TABLE_SIZE = 11;
+    static constexpr float SAMPLE_STEP = 1.0f / (SAMPLE_TABLE_SIZE - 1);
+    static const int NEWTON_ITERATIONS = 4;
+    static constexpr float NEWTON_MIN_SLOPE = 0.001f;
+    static const int BISECTION_ITERATIONS = 24;
+    static constexpr float PRECISION = 1e-6f;
+
+    /**
+     * Find the curve parameter where the x-value of the curve equals t.
+     */
+    float solve(float t) const {
+        int i = 0;
+        while (i < SAMPLE_TABLE_SIZE - 2 && mSamples[i + 1] <= t)
+            i++;
+
+        float left = i * SAMPLE_STEP;
+        float width = mSamples[i + 1] - mSamples[i];
+        float guess = width > 0 ? left + SAMPLE_STEP * (t - mSamples[i]) / width : left;
+
+        // Newton-Raphson converges quickly unless the curve is nearly flat
+        if (slope(mA, mC, guess) >= NEWTON_MIN_SLOPE) {
+            float estimate = guess;
+            for (int k = 0 ; k < NEWTON_ITERATIONS ; k++) {
+                float delta = f(mA, mC, estimate) - t;
+                if (std::fabs(delta) < PRECISION)
+                    return estimate;
+                float s = slope(mA, mC, estimate);
+                if (s < NEWTON_MIN_SLOPE)
+                    break;
+                estimate = std::min(1.0f, std::max(0.0f, estimate - delta / s));
+            }
+            if (std::fabs(f(mA, mC, estimate) - t) < PRECISION)
+                return estimate;
+        }
+
+        float right = left + SAMPLE_STEP;
+        float mid = guess;
+        for (int k = 0 ; k < BISECTION_ITERATIONS ; k++) {
+            mid = (left + right) / 2;
+            float delta = f(mA, mC, mid) - t;
+            if (std::fabs(delta) < PRECISION)
+                break;
+            if (delta < 0)
+                left = mid;
+            else
+                right = mid;
+        }
+        return mid;
+    }
+
     float mA, mB, mC, mD;
+    std::array<float, SAMPLE_TABLE_SIZE> mSamples;
 };
 
 } // namespace apl
@@ -45,6 +45,15 @@ public:
      */
     float operator()(float time);
 
+    /**
+     * Evaluate the easing curve at a number of times between 0 and 1.  This does not update
+     * the cached last value used by operator().
+     * @param time The array of times
+     * @param out The array to store the results in.  It may be the same as time.
+     * @param n The number of values to evaluate.
+     */
+    void calc(const float *time, float *out, size_t n) const;
+
     /**
      * Generate an easing curve from a string.  If the string is invalid, we return a linear easing curve
      * @param easing The character string.
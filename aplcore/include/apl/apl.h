@@ -33,6 +33,7 @@
 #include "apl/content/jsondata.h"
 #include "apl/content/metrics.h"
 #include "apl/content/package.h"
+#include "apl/content/packagecache.h"
 #include "apl/content/rootconfig.h"
 #include "apl/engine/event.h"
 #include "apl/engine/rootcontext.h"
@@ -52,8 +52,10 @@ class Context;
 class CoreComponent;
 class GraphicContent;
 class GraphicElement;
+class GraphicPath;
 class Graphic;
 class Package;
+class PackageCache;
 class RootContext;
 class Session;
 class StyleDefinition;
@@ -69,8 +71,10 @@ using ContextPtr = std::shared_ptr<Context>;
 using CoreComponentPtr = std::shared_ptr<CoreComponent>;
 using GraphicContentPtr = std::shared_ptr<GraphicContent>;
 using GraphicElementPtr = std::shared_ptr<GraphicElement>;
+using GraphicPathPtr = std::shared_ptr<GraphicPath>;
 using GraphicPtr = std::shared_ptr<Graphic>;
 using PackagePtr = std::shared_ptr<Package>;
+using PackageCachePtr = std::shared_ptr<PackageCache>;
 using RootContextPtr = std::shared_ptr<RootContext>;
 using SessionPtr = std::shared_ptr<Session>;
 using StyleDefinitionPtr = std::shared_ptr<StyleDefinition>;
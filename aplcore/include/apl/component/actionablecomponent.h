@@ -17,6 +17,7 @@
 #define _APL_ACTIONABLE_COMPONENT_H
 
 #include "corecomponent.h"
+#include "apl/engine/keyboardmanager.h"
 
 namespace apl {
 
@@ -39,6 +40,9 @@ protected:
 
     const ComponentPropDefSet& propDefSet() const override;
 
+private:
+    // Key handlers are parsed the first time a key event reaches this component
+    std::map<KeyHandlerType, KeyHandlerList> mKeyHandlers;
 };
 
 } // namespace apl
@@ -202,9 +202,16 @@ public:
     virtual ComponentType getType() const = 0;
 
     /**
-     * @return The unique ID assigned to this component by the system.
+     * @return The unique ID assigned to this component by the system.  This is the string form
+     *         of the numeric unique ID, built when requested.
      */
-    std::string getUniqueId() const { return mUniqueId; }
+    std::string getUniqueId() const { return ':' + std::to_string(mUniqueId); }
+
+    /**
+     * @return The numeric unique ID assigned to this component by the system.  Use this for
+     *         identity comparisons and as a key; it is cheaper than the string form.
+     */
+    id_type getUniqueIdNumber() const { return mUniqueId; }
 
     /**
      * @return The ID assigned to this component by the APL author.  If not
@@ -263,9 +270,10 @@ public:
     bool getBoundsInParent(const ComponentPtr& ancestor, Rect& out) const;
 
     /**
-     * @return Global bounds for this component
+     * @return Global bounds for this component.  The result is cached until the bounds, scroll
+     *         position or parent of any component in the document changes.
      */
-    Rect getGlobalBounds() const { Rect r; getBoundsInParent(nullptr, r); return r; }
+    Rect getGlobalBounds() const;
 
     /**
      * @return The type of scrolling supported by this component.
@@ -373,7 +381,7 @@ public:
     /**
      * Equality operator override
      */
-    bool operator==(const ComponentPtr& other) const { return mUniqueId == other->getUniqueId(); }
+    bool operator==(const ComponentPtr& other) const { return mUniqueId == other->mUniqueId; }
 
 protected:
     Component(const ContextPtr& context, const std::string& id);
@@ -384,12 +392,17 @@ protected:
     static id_type             sUniqueIdGenerator;
 
     ContextPtr   mContext;
-    std::string                mUniqueId;
+    id_type                    mUniqueId;
     std::string                mId;
     CalculatedPropertyMap      mCalculated;  // Current calculated object properties
     std::set<PropertyKey>      mDirty;
     bool                       mIsValid;
 
+private:
+    mutable Rect               mGlobalBounds;
+    mutable unsigned int       mGlobalBoundsGeneration;
+    mutable bool               mGlobalBoundsValid;
+
 
 };
 
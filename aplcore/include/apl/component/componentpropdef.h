@@ -154,7 +154,16 @@ public:
     ComponentPropDefSet& add(const std::vector<ComponentPropDef>& list) {
         addInternal(list);
 
+        // Copy-on-write: sets built from this one may still share the old defaults
+        auto defaults = mDefaults ? std::make_shared<CalculatedPropertyMap::Map>(*mDefaults)
+                                  : std::make_shared<CalculatedPropertyMap::Map>();
+
         for (const ComponentPropDef& m : list) {
+            if (m.defaultFunc)
+                defaults->erase(m.key);
+            else
+                (*defaults)[m.key] = m.defvalue;
+
             if ((m.flags & kPropStyled) != 0)
                 addToMap(mStyled, m);
 
@@ -165,9 +174,15 @@ public:
                 addToMap(mNeedsNode, m);
         }
 
+        mDefaults = defaults;
         return *this;
     }
 
+    /**
+     * @return The shared default values of every property that does not use a default function
+     */
+    const CalculatedPropertyMap::MapPtr& defaults() const { return mDefaults; }
+
     /**
      * @return The styled properties
      */
@@ -187,6 +202,7 @@ private:
     PMap mStyled;
     PMap mDynamic;
     PMap mNeedsNode;
+    CalculatedPropertyMap::MapPtr mDefaults;
 };
 
 }  // namespace apl
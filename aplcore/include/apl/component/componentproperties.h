@@ -396,7 +396,9 @@ enum PropertyKey {
     /// Component handler for cursor enter
     kPropertyOnCursorEnter,
     /// Component handler for cursor exit
-    kPropertyOnCursorExit
+    kPropertyOnCursorExit,
+    /// VectorGraphicComponent changed graphic elements (output only, see RootConfig::incrementalGraphicUpdates)
+    kPropertyGraphicChanges
 };
 
 // Be careful adding new items to this list or changing the order of the list.
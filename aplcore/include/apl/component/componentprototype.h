@@ -0,0 +1,98 @@
+/**
+ * Copyright 2019 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef _APL_COMPONENT_PROTOTYPE_H
+#define _APL_COMPONENT_PROTOTYPE_H
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "rapidjson/document.h"
+
+#include "apl/component/componentproperties.h"
+#include "apl/primitives/object.h"
+
+namespace apl {
+
+/**
+ * The component properties of a single JSON component template, compiled once and shared by every
+ * component inflated from that template.  This is what a layout or a Sequence item template turns
+ * into the first time it is instantiated.
+ *
+ * The property names are resolved to property keys and sorted by key, which is the order of the
+ * property definition sets.  Each value is split into constant or bound.  A constant value is not
+ * a string, or is a plain string; it is used as-is.  A bound value is a string that may contain a
+ * data-binding expression or name a resource; it must be evaluated against the context of each
+ * instance.  Parsed expressions are not kept, because parsing folds in the constants of the
+ * context it runs in.
+ */
+class ComponentPrototype {
+public:
+    struct Entry {
+        PropertyKey key;
+        Object value;
+        bool bound;
+    };
+
+    /**
+     * Compile a JSON component template.
+     * @param json The template.  Must be a JSON object.
+     */
+    explicit ComponentPrototype(const rapidjson::Value& json);
+
+    /**
+     * Check that this prototype was compiled from a template.  The member names are compared by
+     * address, so a cache keyed by template address detects a template freed and replaced by
+     * another at the same address.
+     * @param json The template.
+     * @return True if this prototype was compiled from the template.
+     */
+    bool matches(const rapidjson::Value& json) const;
+
+    /**
+     * @return The component properties of the template sorted by property key.
+     */
+    const std::vector<Entry>& entries() const { return mEntries; }
+
+private:
+    std::vector<Entry> mEntries;
+    std::vector<const char *> mNames;
+};
+
+/**
+ * The component prototypes of a document, keyed by JSON template.
+ */
+class ComponentPrototypes {
+public:
+    /**
+     * Return the prototype of a JSON component template, compiling it the first time it is used.
+     * @param json The template.  Must be a JSON object that lives as long as the document.
+     * @return The prototype.
+     */
+    const ComponentPrototype& get(const rapidjson::Value& json);
+
+    /**
+     * @return The number of compiled prototypes.
+     */
+    size_t size() const { return mPrototypes.size(); }
+
+private:
+    std::unordered_map<const rapidjson::Value*, std::unique_ptr<ComponentPrototype>> mPrototypes;
+};
+
+} // namespace apl
+
+#endif //_APL_COMPONENT_PROTOTYPE_H
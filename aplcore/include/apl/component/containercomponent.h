@@ -34,9 +34,9 @@ protected:
 
 private:
     bool multiChild() const override { return true; }
-    std::map<int,int> calculateChildrenVisualLayer(const std::map<int, float>& visibleIndexes,
-                                                   const Rect& visibleRect, int visualLayer) override;
-    std::map<int, float> getChildrenVisibility(float realOpacity, const Rect &visibleRect) override;
+    std::vector<int> calculateChildrenVisualLayer(const std::vector<std::pair<int, float>>& visibleIndexes,
+                                                  const std::vector<Rect>& visibleRects, int visualLayer) override;
+    std::vector<std::pair<int, float>> getChildrenVisibility(float realOpacity, const Rect &visibleRect) override;
 };
 
 } // namespace apl
@@ -28,6 +28,7 @@ namespace apl {
 
 class ComponentPropDef;
 class ComponentPropDefSet;
+class ExpressionMemo;
 
 extern const std::string VISUAL_CONTEXT_TYPE_MIXED;
 extern const std::string VISUAL_CONTEXT_TYPE_GRAPHIC;
@@ -168,8 +169,10 @@ public:
      * A context that this property depends upon has changed value.  Recalculate the
      * value of the property
      * @param key The property to recalculate
+     * @param memo The memo holding the last value of the property expression.  The property is
+     *             only recalculated if the expression produces a new value.
      */
-    void recalculateProperty(PropertyKey key);
+    void recalculateProperty(PropertyKey key, ExpressionMemo& memo);
 
     /**
      * Change the state of the component.  This may trigger a style change in
@@ -356,6 +359,17 @@ public:
      */
     ContextPtr createKeyboardEventContext(const std::string& handler, const ObjectMapPtr& keyboard) const;
 
+    /**
+     * Create the data-binding context for the commands of an event handler property.  The event
+     * properties are only built if the commands may read "event"; otherwise the commands run
+     * directly in the component context.
+     * @param key The handler property.
+     * @param handler Handler name.
+     * @param value The "value" to be used for this component.
+     * @return The data-binding context for the handler commands.
+     */
+    ContextPtr createHandlerContext(PropertyKey key, const std::string& handler, const Object& value);
+
     virtual const ComponentPropDefSet& propDefSet() const;
 
     /**
@@ -411,9 +425,9 @@ public:
      * Get visible children of component and respective visibility values.
      * @param realOpacity cumulative opacity.
      * @param visibleRect component's visible rect.
-     * @return Map of visible children indexes to respective visibility values.
+     * @return Visible children indexes and respective visibility values, in ascending index order.
      */
-    virtual std::map<int, float> getChildrenVisibility(float realOpacity, const Rect& visibleRect);
+    virtual std::vector<std::pair<int, float>> getChildrenVisibility(float realOpacity, const Rect& visibleRect);
 
     /**
      * @return Type of visual context.
@@ -422,13 +436,13 @@ public:
 
     /**
      * Calculate visual layer.
-     * @param visibleIndexes Map of visible children indexes to respective visibility values.
-     * @param visibleRect component's visible rect.
+     * @param visibleIndexes Visible children indexes and respective visibility values.
+     * @param visibleRects The visible rect of each child in visibleIndexes, in the same order.
      * @param visualLayer component's visual layer.
-     * @return map from child index to it's visual layer value.
+     * @return The visual layer of each child in visibleIndexes, in the same order.
      */
-    virtual std::map<int, int> calculateChildrenVisualLayer(const std::map<int, float>& visibleIndexes,
-                                                            const Rect& visibleRect, int visualLayer);
+    virtual std::vector<int> calculateChildrenVisualLayer(const std::vector<std::pair<int, float>>& visibleIndexes,
+                                                          const std::vector<Rect>& visibleRects, int visualLayer);
 
     /**
     * Calculate real opacity of component.
@@ -469,6 +483,11 @@ public:
      */
     virtual ComponentPtr findChildAtPosition(const Point& position) const;
 
+    /**
+     * Called after a child has been inserted into or removed from this component.
+     */
+    virtual void childrenChanged() {}
+
     /**
      * Checks to see if this Component inherits state from another Component. State
      * is inherited if compare Component is an ancestor, and inheritParentState = true for this Component
@@ -499,6 +518,8 @@ private:
 
     void removeChild(const CoreComponentPtr& child, bool useDirtyFlag);
 
+    ComponentPtr findComponentById(const std::string& id, id_type uniqueId) const;
+
     void markRemoved();
 
     void markAdded();
@@ -512,7 +533,7 @@ private:
 
     bool markPropertyInternal(const ComponentPropDefSet& propDefSet, PropertyKey key);
 
-    bool recalculatePropertyInternal(const ComponentPropDefSet& propDefSet, PropertyKey key, const Object& node);
+    bool recalculatePropertyInternal(const ComponentPropDefSet& propDefSet, PropertyKey key, const Object& value);
 
     void handlePropertyChange(const ComponentPropDef& def, const Object& value);
 
@@ -520,7 +541,10 @@ private:
 
     const ComponentPropDefSet* getLayoutPropDefSet() const;
 
-    void updateStyleInternal(const StyleInstancePtr& stylePtr, const ComponentPropDefSet& propDefSet);
+    void updateStyleInternal(const StyleInstancePtr& oldStyle, const StyleInstancePtr& newStyle,
+                             const ComponentPropDefSet& propDefSet);
+
+    void updateStyledProperty(const ComponentPropDefSet& propDefSet, PropertyKey key, const Object *styleValue);
 
     virtual const ComponentPropDefSet* layoutPropDefSet() const { return nullptr; };
 
@@ -537,6 +561,8 @@ private:
 
     std::shared_ptr<ObjectMap> createEventProperties(const std::string& handler, const Object& value) const;
 
+    // Handler properties are not dynamic, so each one is checked for "event" once
+    std::map<PropertyKey, bool> mHandlerUsesEvent;
 
 protected:
     bool                           mInheritParentState;
@@ -544,6 +570,7 @@ protected:
     std::string                    mStyle;       // Name of the current STYLE
     Properties                     mProperties;  // Assigned properties from JSON
     std::map<PropertyKey, Object>  mAssigned;    // Assigned properties from either JSON or SetValue
+    StyleInstancePtr               mAppliedStyle; // Style the styled properties were last calculated from
     std::vector<CoreComponentPtr>  mChildren;
     CoreComponentPtr               mParent;
     YGNodeRef                      mYGNodeRef;
@@ -51,7 +51,7 @@ protected:
 
 private:
     bool multiChild() const override { return true; }
-    std::map<int, float> getChildrenVisibility(float realOpacity, const Rect &visibleRect) override;
+    std::vector<std::pair<int, float>> getChildrenVisibility(float realOpacity, const Rect &visibleRect) override;
 
     int mCurrentPage;  // Current page we're on
 
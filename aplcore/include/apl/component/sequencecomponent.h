@@ -45,14 +45,28 @@ protected:
 
     void update(UpdateType type, float value) override;
     ComponentPtr findChildAtPosition(const Point& position) const override;
+    void processLayoutChanges(bool useDirtyFlag) override;
+    void childrenChanged() override { mChildExtentsValid = false; }
 
 private:
     bool multiChild() const override { return true; }
-    std::map<int, float> getChildrenVisibility(float realOpacity, const Rect &visibleRect) override;
+    std::vector<std::pair<int, float>> getChildrenVisibility(float realOpacity, const Rect &visibleRect) override;
     void updateSeen();
+    void updateChildExtents();
 
     int mHighestIndexSeen;
     int mFirstUnensuredChild;
+
+    // Index of the laid-out children along the scroll axis.  mExtentEndMax[i] is the largest
+    // far edge of children 0..i and mExtentStartMin[i] is the smallest near edge of children
+    // i..n-1.  Both are sorted, so the children that may contain a point can be found with
+    // a binary search even if some children are out of order (for example, display "none").
+    // Only ensured children are indexed.  ScrollToIndex does not map an index to an estimated
+    // offset: yoga positions a child only after every earlier child is attached, so the target
+    // and the children before it are laid out before the scroll position is computed.
+    std::vector<float> mExtentEndMax;
+    std::vector<float> mExtentStartMin;
+    bool mChildExtentsValid;
 };
 
 } // namespace apl
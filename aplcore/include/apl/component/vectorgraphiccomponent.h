@@ -34,6 +34,13 @@ public:
     std::shared_ptr<ObjectMap> getEventTargetProperties() const override;
 
     bool updateGraphic(const GraphicContentPtr& json) override;
+    rapidjson::Value serializeDirty(rapidjson::Document::AllocatorType& allocator) override;
+
+    /**
+     * Mark that elements of the current graphic have changed.  This sets kPropertyGraphicChanges
+     * if incremental graphic updates are enabled and kPropertyGraphic otherwise.
+     */
+    void setGraphicDirty();
 
 protected:
     const ComponentPropDefSet& propDefSet() const override;
@@ -78,6 +78,20 @@ public:
      */
     static ContentPtr create(JsonData&& document, const SessionPtr& session);
 
+    /**
+     * Construct the working Content object from a document, using a package cache that may
+     * be shared with other Content objects.  Imports found in the cache are resolved
+     * immediately and are not returned by getRequestedPackages().  Packages added with
+     * addPackage() are stored in the cache.  Cached packages may outlive the JsonData they
+     * were added with, so a package that references a caller-owned rapidjson::Value or an
+     * in-situ buffer (see JsonData::ownsData()) is deep-copied before it is cached.
+     * @param document The JSON document
+     * @param session A logging session
+     * @param cache The package cache.  May be null.
+     * @return A pointer to the content or nullptr if invalid
+     */
+    static ContentPtr create(JsonData&& document, const SessionPtr& session, const PackageCachePtr& cache);
+
     /**
      * @return The main document package
      */
@@ -172,15 +186,18 @@ public:
      * @param mainPackagePtr
      * @param mainTemplate
      * @param parameterNames
+     * @param cache
      */
     Content(const SessionPtr& session,
             const PackagePtr& mainPackagePtr,
             const rapidjson::Value& mainTemplate,
-            std::vector<std::string>&& parameterNames);
+            std::vector<std::string>&& parameterNames,
+            const PackageCachePtr& cache = nullptr);
 
 private:  // Private internal methods
-    void addImportList(Package& package);
-    void addImport(Package& package, const rapidjson::Value& value);
+    void addImportList(const Package& package);
+    void addImport(const Package& package, const rapidjson::Value& value);
+    void addLoaded(const ImportRef& ref, const PackagePtr& package);
     void updateStatus();
 
 private:
@@ -191,6 +208,7 @@ private:
     };
 
     SessionPtr mSession;
+    PackageCachePtr mCache;
     PackagePtr mMainPackage;
     std::vector<std::string> mMainParameters;
 
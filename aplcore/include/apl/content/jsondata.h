@@ -16,10 +16,13 @@
 #ifndef _APL_JSON_H
 #define _APL_JSON_H
 
+#include <chrono>
+#include <cstdio>
 #include <string>
 
 #include "rapidjson/document.h"
 #include "rapidjson/error/en.h"
+#include "rapidjson/filereadstream.h"
 
 namespace apl {
 
@@ -34,7 +37,8 @@ namespace apl {
 class JsonData {
 public:
     /**
-     * Initialize by moving an existing JSON document.
+     * Initialize by moving an existing JSON document.  If the document was parsed in situ,
+     * another agent must keep its buffer alive during the lifespan of this object.
      * @param document
      */
     JsonData(rapidjson::Document&& document)
@@ -52,6 +56,7 @@ public:
      */
     JsonData(const rapidjson::Value& value)
         : mHasDocument(false),
+          mOwnsData(false),
           mValue(value)
     {}
 
@@ -62,9 +67,11 @@ public:
     JsonData(const std::string& raw)
         : mHasDocument(true),
           mDocument(),
-          mOk(mDocument.Parse<rapidjson::kParseValidateEncodingFlag | rapidjson::kParseStopWhenDoneFlag>(raw.c_str())),
           mValue(mDocument)
-    {}
+    {
+        rapidjson::StringStream stream(raw.c_str());
+        parse<PARSE_FLAGS>(stream);
+    }
 
     /**
      * Initialize by parsing a raw string.  The string may be released
@@ -74,22 +81,44 @@ public:
     JsonData(const char *raw)
         : mHasDocument(true),
           mDocument(),
-          mOk(mDocument.Parse<rapidjson::kParseValidateEncodingFlag | rapidjson::kParseStopWhenDoneFlag>(raw)),
           mValue(mDocument)
-    {}
+    {
+        rapidjson::StringStream stream(raw);
+        parse<PARSE_FLAGS>(stream);
+    }
 
     /**
      * Initialize by parsing a raw string in situ.  The string may be
      * modified. Another agent must keep the raw string in memory until
-     * this object is destroyed.
+     * this object is destroyed.  JSON strings are decoded directly into the
+     * raw buffer, so the text is not duplicated in the parsed document.
      * @param raw
      */
     JsonData(char *raw)
         : mHasDocument(true),
+          mOwnsData(false),
           mDocument(),
-          mOk(mDocument.Parse<rapidjson::kParseValidateEncodingFlag | rapidjson::kParseStopWhenDoneFlag>(raw)),
           mValue(mDocument)
-    {}
+    {
+        rapidjson::InsituStringStream stream(raw);
+        parse<PARSE_FLAGS | rapidjson::kParseInsituFlag>(stream);
+    }
+
+    /**
+     * Initialize by parsing from an open file.  The file is read in small
+     * chunks as it is parsed, so the full text is never held in memory.
+     * The file is not closed.
+     * @param file
+     */
+    JsonData(std::FILE *file)
+        : mHasDocument(true),
+          mDocument(),
+          mValue(mDocument)
+    {
+        char buffer[READ_BUFFER_SIZE];
+        rapidjson::FileReadStream stream(file, buffer, sizeof(buffer));
+        parse<PARSE_FLAGS>(stream);
+    }
 
     /**
      * @return True if this appears to be a valid JSON object.
@@ -119,11 +148,50 @@ public:
         return mHasDocument ? mDocument : mValue;
     }
 
+    /**
+     * @return True if this object holds all of its JSON data.  False if it references a
+     *         document or in-situ buffer that is kept alive by another agent.
+     */
+    bool ownsData() const { return mOwnsData; }
+
+    /**
+     * @return The number of bytes of JSON text consumed by the parser.  This is zero
+     *         if the data was not parsed from text.
+     */
+    size_t bytesParsed() const { return mBytesParsed; }
+
+    /**
+     * @return The time spent parsing the JSON text, in seconds.
+     */
+    double parseTime() const { return mParseTime; }
+
+    /**
+     * @return The parse throughput in megabytes per second.  This is zero if the data
+     *         was not parsed from text.
+     */
+    double throughput() const {
+        return mParseTime > 0 ? mBytesParsed / (mParseTime * 1024 * 1024) : 0;
+    }
+
 private:
+    static const unsigned PARSE_FLAGS = rapidjson::kParseValidateEncodingFlag | rapidjson::kParseStopWhenDoneFlag;
+    static const size_t READ_BUFFER_SIZE = 16384;
+
+    template<unsigned parseFlags, typename Stream>
+    void parse(Stream& stream) {
+        auto start = std::chrono::steady_clock::now();
+        mOk = mDocument.ParseStream<parseFlags>(stream);
+        mParseTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        mBytesParsed = stream.Tell();
+    }
+
     bool mHasDocument;
+    bool mOwnsData = true;
     rapidjson::Document mDocument;
     rapidjson::ParseResult mOk;
     const rapidjson::Value& mValue;
+    size_t mBytesParsed = 0;
+    double mParseTime = 0;
 };
 
 } // namespace APL
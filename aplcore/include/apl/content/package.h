@@ -16,7 +16,10 @@
 #ifndef _APL_PACKAGE_H
 #define _APL_PACKAGE_H
 
+#include <algorithm>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 #include "rapidjson/document.h"
@@ -24,6 +27,7 @@
 #include "apl/common.h"
 #include "apl/content/importref.h"
 #include "apl/content/jsondata.h"
+#include "apl/engine/jsonresource.h"
 #include "apl/utils/streamer.h"
 
 namespace apl {
@@ -63,28 +67,58 @@ public:
      */
     const std::string type();
 
-    Package(const std::string& name, JsonData&& json)
-            : mName(name),
-              mJson(std::move(json))
-    {}
+    /**
+     * @return An estimate of the memory used by this package, in bytes.  This is the size
+     *         of the JSON text it was parsed from or, for packages built from an existing
+     *         rapidjson document, an estimate based on the values it contains.
+     */
+    size_t size() const { return mSize; }
+
+    /**
+     * The named layouts, commands, and graphics defined in this package.  These are
+     * extracted the first time they are requested with a given provenance setting and
+     * are shared by every document that uses the package.
+     * @param trackProvenance If true, the resources carry their provenance paths.
+     * @return The definitions, keyed by name.
+     */
+    const std::map<std::string, JsonResource>& layouts(bool trackProvenance) const {
+        return definitions(trackProvenance).layouts;
+    }
+    const std::map<std::string, JsonResource>& commands(bool trackProvenance) const {
+        return definitions(trackProvenance).commands;
+    }
+    const std::map<std::string, JsonResource>& graphics(bool trackProvenance) const {
+        return definitions(trackProvenance).graphics;
+    }
+
+    Package(const std::string& name, JsonData&& json);
 
     friend streamer& operator<<(streamer& os, Package& package) {
         return os << package.name();
     }
 
 private:
-    friend class Content;
     friend class RootContext;
 
-    void addDependency(const ImportRef& ref) { mDependencies.push_back(ref); }
-    void addDependency(ImportRef&& ref) { mDependencies.push_back(ref); }
-
+    // The valid imports of the package, extracted when it is created.  Packages may be shared
+    // between threads through a PackageCache, so they are never modified after construction.
     const std::vector<ImportRef>& getDependencies() const { return mDependencies; }
 
 private:
+    struct Definitions {
+        std::map<std::string, JsonResource> layouts;
+        std::map<std::string, JsonResource> commands;
+        std::map<std::string, JsonResource> graphics;
+        std::once_flag built;
+    };
+
+    const Definitions& definitions(bool trackProvenance) const;
+
     const JsonData mJson;
     std::string mName;
     std::vector<ImportRef> mDependencies;
+    size_t mSize;
+    mutable Definitions mDefinitions[2];    // Indexed by "trackProvenance"; built on first use
 };
 
 } // namespace apl
@@ -0,0 +1,139 @@
+/**
+ * Copyright 2019 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef _APL_PACKAGE_CACHE_H
+#define _APL_PACKAGE_CACHE_H
+
+#include <list>
+#include <map>
+#include <mutex>
+
+#include "apl/common.h"
+#include "apl/content/importref.h"
+
+namespace apl {
+
+/**
+ * A cache of parsed packages that can be shared between Content objects.
+ *
+ * Packages are keyed by ImportRef, so different versions of the same package are cached
+ * separately.  When a Content object with a cache encounters an import that is already
+ * in the cache, the cached package (and, transitively, any of its cached imports) is
+ * added immediately instead of being returned from Content::getRequestedPackages().
+ *
+ * Packages are immutable once loaded and hold the layouts, commands, and graphics they
+ * define, so a cached package is processed once no matter how many documents use it.
+ * A cached package must own its JSON, because it may be used long after the document
+ * that loaded it is gone.  Content copies non-owning package JSON before adding it.
+ *
+ * The cache holds at most "capacity" packages and, if a memory budget is set, at most
+ * "memoryBudget" bytes of packages (as estimated by Package::size()).  When a limit is
+ * exceeded, the least-recently-used package that is not referenced outside of the cache is
+ * dropped; if every package is in use, the least-recently-used package is dropped.
+ * Packages are shared pointers, so dropping a package from the cache does not affect
+ * Content objects that are still using it.
+ *
+ * A single cache may be used from multiple threads.
+ */
+class PackageCache {
+public:
+    /**
+     * Create a package cache.
+     * @param capacity The maximum number of packages to hold.
+     * @param memoryBudget The maximum number of bytes of packages to hold.  Zero for no limit.
+     * @return The cache.
+     */
+    static PackageCachePtr create(size_t capacity = 32, size_t memoryBudget = 0) {
+        return std::make_shared<PackageCache>(capacity, memoryBudget);
+    }
+
+    /**
+     * Use the create() method instead.
+     * @param capacity The maximum number of packages to hold.
+     * @param memoryBudget The maximum number of bytes of packages to hold.  Zero for no limit.
+     */
+    PackageCache(size_t capacity, size_t memoryBudget)
+        : mCapacity(capacity),
+          mMemoryBudget(memoryBudget)
+    {}
+
+    /**
+     * Look up a package.  A successful look up marks the package as most recently used.
+     * @param ref The package name and version.
+     * @return The package or nullptr if it is not in the cache.
+     */
+    PackagePtr find(const ImportRef& ref);
+
+    /**
+     * Add a package to the cache, replacing any existing package with the same reference.
+     * @param ref The package name and version.
+     * @param package The package.
+     */
+    void add(const ImportRef& ref, const PackagePtr& package);
+
+    /**
+     * Remove all packages from the cache.
+     */
+    void clear();
+
+    /**
+     * @return The number of packages in the cache.
+     */
+    size_t size() const;
+
+    /**
+     * @return The maximum number of packages held by the cache.
+     */
+    size_t capacity() const { return mCapacity; }
+
+    /**
+     * @return The maximum number of bytes of packages held by the cache.  Zero for no limit.
+     */
+    size_t memoryBudget() const { return mMemoryBudget; }
+
+    /**
+     * @return The estimated number of bytes used by the packages in the cache.
+     */
+    size_t memoryUse() const;
+
+    /**
+     * @return The number of successful look ups.
+     */
+    size_t hits() const;
+
+    /**
+     * @return The number of failed look ups.
+     */
+    size_t misses() const;
+
+private:
+    using Entry = std::pair<ImportRef, PackagePtr>;
+
+    bool overLimit() const;
+    void evictOne();
+
+    const size_t mCapacity;
+    const size_t mMemoryBudget;
+    size_t mMemoryUse = 0;
+    mutable std::mutex mMutex;
+    std::list<Entry> mEntries;    // Most recently used at the front
+    std::map<ImportRef, std::list<Entry>::iterator> mIndex;
+    size_t mHits = 0;
+    size_t mMisses = 0;
+};
+
+} // namespace apl
+
+#endif //_APL_PACKAGE_CACHE_H
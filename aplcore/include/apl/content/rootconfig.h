@@ -116,6 +116,31 @@ public:
         return *this;
     }
 
+    /**
+     * Allow the view host to run AnimateItem commands itself.  When enabled, eligible animations
+     * are sent once as a kEventTypeAnimateItem event instead of updating component properties
+     * on every frame.
+     * @param offload True if the view host will run eligible animations.
+     * @return This object for chaining
+     */
+    RootConfig& offloadAnimations(bool offload) {
+        mOffloadAnimations = offload;
+        return *this;
+    }
+
+    /**
+     * Report changes to the elements of a vector graphic incrementally.  When enabled, a change
+     * to an existing graphic marks kPropertyGraphicChanges dirty instead of kPropertyGraphic, and
+     * the serialized component carries only the changed elements and properties.  A new graphic
+     * is still reported as kPropertyGraphic.
+     * @param incremental True if the view host applies incremental graphic updates.
+     * @return This object for chaining
+     */
+    RootConfig& incrementalGraphicUpdates(bool incremental) {
+        mIncrementalGraphicUpdates = incremental;
+        return *this;
+    }
+
     /**
      * Set the default idle timeout.
      * @param idleTimeout Device wide idle timeout..
@@ -202,6 +227,16 @@ public:
         return *this;
     }
 
+    /**
+     * Compile data-binding expressions to bytecode instead of evaluating the parsed node tree.
+     * @param compileExpressions True if expressions should be compiled.
+     * @return This object for chaining.
+     */
+    RootConfig& compileExpressions(bool compileExpressions) {
+        mCompileExpressions = compileExpressions;
+        return *this;
+    }
+
     /**
      * Set the default size of a built-in component.  This applies to both horizontal and vertical components
      * @param type The component type.
@@ -294,6 +329,16 @@ public:
         }
     }
 
+    /**
+     * @return True if the view host runs eligible AnimateItem commands
+     */
+    bool getOffloadAnimations() const { return mOffloadAnimations; }
+
+    /**
+     * @return True if changes to vector graphic elements are reported incrementally
+     */
+    bool getIncrementalGraphicUpdates() const { return mIncrementalGraphicUpdates; }
+
     /**
      * @return True if the OpenURL command is supported
      */
@@ -344,6 +389,11 @@ public:
      */
     bool getTrackProvenance() const { return mTrackProvenance; }
 
+    /**
+     * @return True if data-binding expressions are compiled to bytecode.
+     */
+    bool getCompileExpressions() const { return mCompileExpressions; }
+
     /**
      * Return the default width for this component type.
      * @param type The component type.
@@ -403,6 +453,8 @@ private:
     std::string mAgentName;
     std::string mAgentVersion;
     AnimationQuality mAnimationQuality;
+    bool mOffloadAnimations;
+    bool mIncrementalGraphicUpdates;
     bool mAllowOpenUrl;
     bool mDisallowVideo;
     int mDefaultIdleTimeout;
@@ -413,6 +465,7 @@ private:
     std::map<std::string, Color> mDefaultThemeFontColor;
     std::string mDefaultFontFamily;
     bool mTrackProvenance;
+    bool mCompileExpressions;
     std::map<std::pair<ComponentType, bool>, std::pair<Dimension, Dimension>> mDefaultComponentSize;
     SessionPtr mSession;
 };
@@ -0,0 +1,105 @@
+/**
+ * Copyright 2019 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef _APL_BYTECODE_H
+#define _APL_BYTECODE_H
+
+#include <cstdint>
+#include <vector>
+
+#include "apl/datagrammar/functions.h"
+#include "apl/datagrammar/node.h"
+
+namespace apl {
+namespace datagrammar {
+
+enum ByteCodeOpcode : uint8_t {
+    /** Push constant[value] */
+    kByteCodeLoadConstant,
+    /** Push the context value named by constant[value] */
+    kByteCodeLoadSymbol,
+    /** Push the result of evaluating the node tree in constant[value] */
+    kByteCodeLoadNode,
+    /** Replace the top of the stack with unary(top) */
+    kByteCodeUnary,
+    /** Pop two values and push binary(a, b) */
+    kByteCodeBinary,
+    /** Replace the top of the stack with binary(top, constant[value]) */
+    kByteCodeBinaryConstant,
+    /** Replace the top of the stack with binary(constant[value], top) */
+    kByteCodeConstantBinary,
+    /** If the top of the stack is falsy jump to value, otherwise pop it */
+    kByteCodeAndJump,
+    /** If the top of the stack is truthy jump to value, otherwise pop it */
+    kByteCodeOrJump,
+    /** If the top of the stack is not null jump to value, otherwise pop it */
+    kByteCodeNullcJump,
+    /** Pop the top of the stack and jump to value if it is falsy */
+    kByteCodePopJumpIfFalse,
+    /** Jump to value */
+    kByteCodeJump,
+    /** Pop the evaluated nodes of the combine node in constant[value] and push the combined string */
+    kByteCodeCombine,
+    /** Pop value arguments and a function and push the result of calling the function */
+    kByteCodeCall
+};
+
+struct ByteCodeInstruction {
+    ByteCodeOpcode opcode;
+    int value;
+    union {
+        UnaryFunc unary;
+        BinaryFunc binary;
+    };
+};
+
+/**
+ * An alternative evaluation backend for data-binding expressions.  The node tree built by the
+ * parser is compiled into a flat instruction list that runs on a small value stack, so
+ * evaluation doesn't recurse through the tree or build an argument vector for each node.
+ *
+ * A ByteCode is a Node whose single argument is the original tree.  Symbol extraction and
+ * visitors see the original tree; evaluation runs the compiled program.  Node types the compiler
+ * does not recognize are evaluated as trees from within the program.
+ *
+ * Compilation is enabled with RootConfig::compileExpressions().
+ */
+class ByteCode : public Node {
+public:
+    /**
+     * Compile a parsed data-binding expression.
+     * @param object The result of parsing a data-binding expression.
+     * @return A compiled node if the object is a node; otherwise the object itself.
+     */
+    static Object compile(const Object& object);
+
+    explicit ByteCode(const Object& tree);
+
+    Object eval(const Context& context) const override;
+
+    const std::vector<ByteCodeInstruction>& instructions() const { return mInstructions; }
+
+private:
+    friend class ByteCodeCompiler;
+
+    std::vector<ByteCodeInstruction> mInstructions;
+    std::vector<Object> mConstants;
+    size_t mMaxDepth;
+};
+
+} // namespace datagrammar
+} // namespace apl
+
+#endif // _APL_BYTECODE_H
@@ -19,6 +19,9 @@
 #define _APL_DATA_BINDING_STACK_H
 
 #include <cstdio>
+#include <iterator>
+#include <vector>
+
 #include <pegtl.hh>
 #include "databindinggrammar.h"
 #include "functions.h"
@@ -122,33 +125,42 @@ public:
         mObjects.push_back(object);
     }
 
+    // Operators are static definitions, so the stack only records their address
     void push(const Operator& op)
     {
         LOG_IF(DEBUG_STATE) << "Stack[" << mDepth << "].push( " << op.name << " )";
-        mOps.push_back(op);
+        mOps.push_back(&op);
     }
 
     void pop(const Operator& op) {
         LOG_IF(DEBUG_STATE) << "Stack[" << mDepth << "].pop(" << op.name << " ) " << toString();
         assert(!mOps.empty());
-        assert(mOps.back().order == op.order);
+        assert(mOps.back()->order == op.order);
         mOps.pop_back();
     }
 
+    // Drop the contents, keeping the allocated buffers for the next parse
+    void clear()
+    {
+        mObjects.clear();
+        mOps.clear();
+    }
+
     // Reduce left-to-right a series of binary operations
     void reduceLR(int order)
     {
         // Search from the back to the starting position with the first operator to combine
         auto backIter = mOps.rbegin();
-        while ( backIter != mOps.rend() && backIter->order == order)
+        while ( backIter != mOps.rend() && (*backIter)->order == order)
             backIter++;
 
         auto opIter = backIter.base();  // Points to the first valid operator
         auto objectIter = mObjects.end() - (mOps.end() - opIter + 1);  // Points to the starting object
 
         while (opIter != mOps.end()) {
-            LOG_IF(DEBUG_STATE) << "Reducing " << opIter->name;
-            auto node = opIter->func(std::vector<Object>(objectIter, objectIter+2));
+            LOG_IF(DEBUG_STATE) << "Reducing " << (*opIter)->name;
+            auto node = (*opIter)->func(std::vector<Object>(std::make_move_iterator(objectIter),
+                                                            std::make_move_iterator(objectIter + 2)));
             *objectIter = node;
             mObjects.erase( objectIter + 1, objectIter + 2);
             opIter = mOps.erase(opIter);
@@ -158,10 +170,11 @@ public:
     // Reduce a unary operation.  Return true if we found a unary operation to reduce
     bool reduceUnary(int order) {
         auto back = mOps.rbegin();
-        if (back == mOps.rend() || back->order != order)
+        if (back == mOps.rend() || (*back)->order != order)
             return false;
 
-        auto node = back->func(std::vector<Object>(mObjects.end() - 1, mObjects.end()));
+        auto node = (*back)->func(std::vector<Object>(std::make_move_iterator(mObjects.end() - 1),
+                                                      std::make_move_iterator(mObjects.end())));
         mObjects.pop_back();
         mObjects.emplace_back(std::move(node));
         mOps.pop_back();
@@ -171,11 +184,12 @@ public:
     // Reduce a single binary operation at the end
     void reduceBinary(int order) {
         auto back = mOps.rbegin();
-        if (back == mOps.rend() || back->order != order)
+        if (back == mOps.rend() || (*back)->order != order)
             return;
 
         assert(mObjects.size() >= 2);
-        auto node = back->func(std::vector<Object>(mObjects.end() - 2, mObjects.end()));
+        auto node = (*back)->func(std::vector<Object>(std::make_move_iterator(mObjects.end() - 2),
+                                                      std::make_move_iterator(mObjects.end())));
         mObjects.pop_back();
         mObjects.pop_back();
         mOps.pop_back();
@@ -185,49 +199,43 @@ public:
     // Reduce a ternary operation at the end
     void reduceTernary(int order) {
         auto back = mOps.rbegin();
-        if (back == mOps.rend() || back->order != order)
+        if (back == mOps.rend() || (*back)->order != order)
             return;
 
         back++;
-        assert(back != mOps.rend() && back->order == order);
-        auto node = back->func(std::vector<Object>(mObjects.end() - 3, mObjects.end()));
+        assert(back != mOps.rend() && (*back)->order == order);
+        auto node = (*back)->func(std::vector<Object>(std::make_move_iterator(mObjects.end() - 3),
+                                                      std::make_move_iterator(mObjects.end())));
         mObjects.erase(mObjects.end() - 3, mObjects.end());
         mOps.erase(mOps.end() - 2, mOps.end());
         mObjects.emplace_back(std::move(node));
     }
 
+    // Combine the contents into a single object.  The contents are moved out; the stack is discarded afterwards.
     Object combine(CombineType combineType)
     {
         LOG_IF(DEBUG_STATE) << "[" << mDepth << "] Stack.combine";
 
         switch (combineType) {
             case kCombineEmbeddedString:
-                // If there's nothing, we started with an empty string
-                if (mObjects.empty())
-                    return Object("");
-
-                if (mObjects.size() == 1)
-                    return mObjects.back();
-
-                return Combine(std::vector<Object>(mObjects.begin(), mObjects.end()));
-
             case kCombineTopString:
                 // If there's nothing, we started with an empty string
                 if (mObjects.empty())
                     return Object("");
 
                 if (mObjects.size() == 1)
-                    return mObjects.back();
+                    return std::move(mObjects.back());
 
-                return Combine(std::vector<Object>(mObjects.begin(), mObjects.end()));
+                return Combine(std::vector<Object>(std::make_move_iterator(mObjects.begin()),
+                                                   std::make_move_iterator(mObjects.end())));
 
             case kCombineVector:
-                // TODO: Do we have move assignment?
-                return Object(std::make_shared<std::vector<Object> >(mObjects));
+                return Object(std::make_shared<std::vector<Object> >(std::make_move_iterator(mObjects.begin()),
+                                                                     std::make_move_iterator(mObjects.end())));
 
             case kCombineSingle:
                 assert(mObjects.size());
-                return mObjects.back();
+                return std::move(mObjects.back());
         }
 
         throw std::runtime_error("Illegal combination");
@@ -244,12 +252,12 @@ public:
         buf << "[";
         auto it = mOps.begin();
         if (it != mOps.end()) {
-            buf << it->name;
+            buf << (*it)->name;
             it++;
         }
 
         while (it != mOps.end()) {
-            buf << "," << it->name;
+            buf << "," << (*it)->name;
             it++;
         }
 
@@ -272,58 +280,88 @@ public:
 private:
     int mDepth;
     std::vector<Object> mObjects;
-    std::vector<Operator> mOps;
+    std::vector<const Operator*> mOps;
 };
 
+/**
+ * The parser state: one Stack for each nested string, group or argument list.  A Stacks object
+ * may be reused for many parses; the per-level buffers are kept so that parsing a typical
+ * expression does not allocate any parser state.
+ */
 class Stacks
 {
 public:
+    Stacks() = default;
+
     // Start with an initial stack that is handling the outer string context
-    Stacks(const Context& context) : mContext(context) {
+    Stacks(const Context& context) { start(context); }
+
+    /**
+     * Prepare to parse a new string
+     * @param context The data-binding context used to resolve constant symbols
+     */
+    void start(const Context& context)
+    {
+        clear();
+        mContext = &context;
         open();
     }
 
+    /**
+     * Release the objects held from the last parse.  The buffers are retained.
+     */
+    void clear()
+    {
+        for (size_t i = 0 ; i < mDepth ; i++)
+            mStack[i].clear();
+        mDepth = 0;
+        mContext = nullptr;
+    }
+
     // Call this when you start processing a new string region or list of arguments
     void open()
     {
         LOG_IF(DEBUG_STATE) << "Stacks.open";
-        mStack.emplace_back(Stack(mStack.size() + 1));
+        if (mDepth == mStack.size())
+            mStack.emplace_back(Stack(mDepth + 1));
+        mDepth++;
     }
 
     // Call this when you stop processing a region (string, parenthesis, arglist)
     void close(CombineType combineType)
     {
         LOG_IF(DEBUG_STATE) << "Stacks.close";
-        auto object = mStack.back().combine(combineType);
-        mStack.pop_back();
-        mStack.back().push(object);
+        auto object = top().combine(combineType);
+        top().clear();
+        mDepth--;
+        top().push(object);
     }
 
     // TODO: Change this to emplace_back
-    void push(const Object& object) { mStack.back().push(object); }
-    void push(const Operator& op) { mStack.back().push(op); }
-    void pop(const Operator& op) { mStack.back().pop(op); }
+    void push(const Object& object) { top().push(object); }
+    void push(const Operator& op) { top().push(op); }
+    void pop(const Operator& op) { top().pop(op); }
 
     /**
      * Reduce any number of operators with the same order, following a left-to-right
      * strategy.  For example, "1 - 3 + 4 - 5" will be resolved as (((1-3)+4)-5).
      * @param order The operator order (see the operator precedence enumeration)
      */
-    void reduceLR(int order) { mStack.back().reduceLR(order); }
+    void reduceLR(int order) { top().reduceLR(order); }
 
     /**
      * Reduce any number of unary operators with the given order.  If the top operator
      * on the stack does not match "order", this method does nothing.
      * @param order The order of the operator
      */
-    void reduceUnary(int order) { while (mStack.back().reduceUnary(order)) ; }
+    void reduceUnary(int order) { while (top().reduceUnary(order)) ; }
 
     /**
      * Reduce a single binary operator with the given order.  If the top operator
      * on the stack does not match "order", this method does nothing.
      * @param order The order of the operator
      */
-    void reduceBinary(int order) { mStack.back().reduceBinary(order); }
+    void reduceBinary(int order) { top().reduceBinary(order); }
 
     /**
      * Reduce a single ternary operator with the given order.  If the top operator
@@ -331,27 +369,31 @@ public:
      * top TWO operators on the stack don't match "order", we throw an exception.
      * @param order The order of the operator.
      */
-    void reduceTernary(int order) { mStack.back().reduceTernary(order); }
+    void reduceTernary(int order) { top().reduceTernary(order); }
 
     Object finish()
     {
         LOG_IF(DEBUG_STATE) << "Stacks.finish";
-        assert(mStack.size() == 1);
-        return mStack.back().combine(kCombineTopString);
+        assert(mDepth == 1);
+        return top().combine(kCombineTopString);
     }
 
     void dump()
     {
-        LOG(LogLevel::DEBUG) << "Stacks=" << mStack.size();
-        for (auto& m : mStack)
-            m.dump();
+        LOG(LogLevel::DEBUG) << "Stacks=" << mDepth;
+        for (size_t i = 0 ; i < mDepth ; i++)
+            mStack[i].dump();
     }
 
-    const Context& context() const { return mContext; }
+    const Context& context() const { return *mContext; }
+
+private:
+    Stack& top() { return mStack[mDepth - 1]; }
 
 private:
     std::vector<Stack> mStack;
-    const Context& mContext;
+    size_t mDepth = 0;
+    const Context *mContext = nullptr;
 };
 } // namespace datagrammar
 } // namespace apl
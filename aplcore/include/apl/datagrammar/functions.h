@@ -55,6 +55,29 @@ extern Object FieldAccess(std::vector<Object>&& );
 extern Object ArrayAccess(std::vector<Object>&& );
 extern Object FunctionCall(std::vector<Object>&& );
 
+// Evaluation functions stored in nodes that have special argument handling
+extern Object EvalAnd(const Context&, const std::vector<Object>&);
+extern Object EvalOr(const Context&, const std::vector<Object>&);
+extern Object EvalNullc(const Context&, const std::vector<Object>&);
+extern Object EvalUnaryTernary(const Context&, const std::vector<Object>&);
+extern Object EvalCombine(const Context&, const std::vector<Object>&);
+extern Object EvalFunctionCall(const Context&, const std::vector<Object>&);
+
+using UnaryFunc = Object (*)(const Object&);
+using BinaryFunc = Object (*)(const Object&, const Object&);
+
+/**
+ * @return The calculation performed by a unary operator node, or nullptr if the node operator
+ *         is not a simple unary operator.
+ */
+extern UnaryFunc unaryCalculation(Object (*op)(const Context&, const std::vector<Object>&));
+
+/**
+ * @return The calculation performed by a binary operator node, or nullptr if the node operator
+ *         is not a simple binary operator.
+ */
+extern BinaryFunc binaryCalculation(Object (*op)(const Context&, const std::vector<Object>&));
+
 } // datagrammar
 } // apl
 
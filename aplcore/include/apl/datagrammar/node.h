@@ -68,6 +68,16 @@ public:
 
     std::string getName() const { return mName; }
 
+    /**
+     * @return The function used to evaluate this node.
+     */
+    OperatorFunc getOperator() const { return mOp; }
+
+    /**
+     * @return The arguments passed to the operator function.
+     */
+    const std::vector<Object>& getArgs() const { return mArgs; }
+
     std::string toDebugString() const override;
 
     friend streamer& operator<<(streamer&, const Node&);
@@ -20,6 +20,7 @@
 
 #include "apl/common.h"
 #include "apl/engine/dependant.h"
+#include "apl/engine/expressionmemo.h"
 #include "apl/component/componentproperties.h"
 
 namespace apl {
@@ -33,7 +34,8 @@ class CoreComponent;
  *
  * The downstream component stores the data-binding expression that will be recalculated, so
  * all this object has to do is inform the downstream component that the specific property
- * should be recalculated.
+ * should be recalculated.  The dependants of a single property share an ExpressionMemo so the
+ * property is only recalculated when the expression produces a new value.
  */
 class ComponentDependant : public Dependant {
 public:
@@ -43,22 +45,27 @@ public:
      * @param upstreamName The name of the symbol in the upstream context which drives a change downstream.
      * @param downstreamComponent The downstream component.
      * @param downstreamKey The property key in the downstream component which will be recalculated.
+     * @param memo The memo shared by all dependants of this property.
      */
     static void create(const ContextPtr& upstreamContext,
                        const std::string& upstreamName,
                        const CoreComponentPtr& downstreamComponent,
-                       PropertyKey downstreamKey);
+                       PropertyKey downstreamKey,
+                       const std::shared_ptr<ExpressionMemo>& memo);
 
     /**
      * Internal constructor: do not call.  Use ComponentDependant::create instead.
      * @param upstreamContext
      * @param downstreamComponent
      * @param propertyKey
+     * @param memo
      */
     ComponentDependant(const ContextPtr& upstreamContext,
                        const CoreComponentPtr& downstreamComponent,
-                       PropertyKey downstreamKey)
-        : mUpstreamContext(upstreamContext), mDownstreamComponent(downstreamComponent), mDownstreamKey(downstreamKey)
+                       PropertyKey downstreamKey,
+                       const std::shared_ptr<ExpressionMemo>& memo)
+        : mUpstreamContext(upstreamContext), mDownstreamComponent(downstreamComponent), mDownstreamKey(downstreamKey),
+          mMemo(memo)
     {}
 
     void removeFromSource() override;
@@ -69,6 +76,7 @@ private:
     std::weak_ptr<Context> mUpstreamContext;
     std::weak_ptr<CoreComponent> mDownstreamComponent;
     PropertyKey mDownstreamKey;
+    std::shared_ptr<ExpressionMemo> mMemo;
 };
 
 
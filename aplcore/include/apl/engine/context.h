@@ -36,6 +36,7 @@ namespace apl {
 
 class Metrics;
 class Styles;
+class ComponentPrototype;
 class RootContextData;
 class State;
 class Event;
@@ -173,6 +174,22 @@ public:
         return false;
     }
 
+    /**
+     * Look up the version of a value in the context.  The version changes each time the value changes.
+     * @param key The string name to look up.
+     * @return The version of the value, or zero if the value doesn't exist.
+     */
+    unsigned int version(const std::string& key) const {
+        auto it = mMap.find(key);
+        if (it != mMap.end())
+            return it->second.version();
+
+        if (mParent)
+            return mParent->version(key);
+
+        return 0;
+    }
+
     /**
      * Find the first context containing a specific key.
      * @param key The key to search for.
@@ -394,6 +411,14 @@ public:
      */
     StyleInstancePtr getStyle(const std::string& name, const State& state);
 
+    /**
+     * Lookup and return the compiled prototype of a JSON component template.  The prototype is
+     * compiled the first time the template is used and shared by the whole document.
+     * @param json The component template.  Must be a JSON object.
+     * @return The component prototype.
+     */
+    const ComponentPrototype& getComponentPrototype(const rapidjson::Value& json);
+
     /**
      * Lookup and return a named command
      * @param name The name of the command
@@ -432,6 +457,27 @@ public:
     void setDirty(const ComponentPtr& ptr);
     void clearDirty(const ComponentPtr& ptr);
 
+    /**
+     * Internal routine used by components to report a change that may affect the visual context.
+     */
+    void visualContextChanged();
+
+    /**
+     * Internal routine used by components to report a change in bounds, scroll position or parent.
+     * Cached global bounds are recalculated after this is called.
+     */
+    void layoutChanged();
+
+    /**
+     * @return A counter that changes whenever the global position of any component may have changed
+     */
+    unsigned int layoutGeneration() const;
+
+    /**
+     * @return Counters for the dependant recalculations performed in this document
+     */
+    RecalculationStats& recalculationStats();
+
     void pushEvent(Event&& event);
 
     Sequencer& sequencer() const;
@@ -20,6 +20,7 @@
 
 #include "apl/engine/builder.h"
 #include "apl/engine/dependant.h"
+#include "apl/engine/expressionmemo.h"
 #include "apl/primitives/object.h"
 
 namespace apl {
@@ -34,7 +35,8 @@ class Context;
  * The dependant stores the parsed Node in the child context.  When the source
  * context value changes, the dependant calculates the new target context value and
  * stores it in the target context.  This normally triggers additional dependants
- * to update their values.
+ * to update their values.  The calculation is skipped when none of the values the Node
+ * reads have changed, and nothing is stored when the result is unchanged.
  */
 class ContextDependant : public Dependant {
 public:
@@ -47,6 +49,8 @@ public:
      * @param evaluationContext The context where the node will be evaluated
      * @param node The Node expression which will be evaluated to recalculate downstream.
      * @param type The type of binding for the Node expression.
+     * @param memo The memo shared by all dependants recalculating this target.  If null, the
+     *             dependant uses a memo of its own.
      */
     static void create(const ContextPtr& upstreamContext,
                        const std::string& upstreamName,
@@ -54,7 +58,8 @@ public:
                        const std::string& downstreamName,
                        const ContextPtr& evaluationContext,
                        const Object& node,
-                       BindingFunction func);
+                       BindingFunction func,
+                       const std::shared_ptr<ExpressionMemo>& memo = nullptr);
 
     /**
      * Internal constructor - do not call. Use ContextDependant::create instead.
@@ -63,19 +68,22 @@ public:
      * @param name
      * @param node
      * @param type
+     * @param memo
      */
     ContextDependant(const ContextPtr& upstreamContext,
                      const ContextPtr& downstreamContext,
                      const ContextPtr& evaluationContext,
                      const std::string& name,
                      const Object& node,
-                     BindingFunction func)
+                     BindingFunction func,
+                     const std::shared_ptr<ExpressionMemo>& memo)
         : mUpstreamContext(upstreamContext),
           mDownstreamContext(downstreamContext),
           mEvaluationContext(evaluationContext),
           mName(name),
           mNode(node),
-          mEval(func)
+          mEval(func),
+          mMemo(memo)
     {}
 
     void removeFromSource() override;
@@ -89,6 +97,7 @@ private:
     std::string mName;
     Object mNode;
     BindingFunction mEval;
+    std::shared_ptr<ExpressionMemo> mMemo;
 };
 
 } // namespace apl
@@ -73,6 +73,11 @@ public:
      */
     bool isUserWriteable() const { return mUserWriteable; }
 
+    /**
+     * @return A counter that changes each time the stored value changes.
+     */
+    unsigned int version() const { return mVersion; }
+
     /**
      * Change the value stored.  Non-mutable objects will never change their value.
      * @param value The new value to store.
@@ -80,8 +85,10 @@ public:
      */
     bool set(const Object& value) {
         bool result = (mMutable && mValue != value);
-        if (result)
+        if (result) {
             mValue = value;
+            mVersion++;
+        }
         return result;
     }
 
@@ -94,6 +101,7 @@ private:
     Path mProvenance;
     bool mMutable = false;
     bool mUserWriteable = false;
+    unsigned int mVersion = 0;
 };
 
 } // namespace apl
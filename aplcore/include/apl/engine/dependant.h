@@ -22,6 +22,22 @@
 
 namespace apl {
 
+/**
+ * Counters describing how much work dependant recalculation performs.  A recalculation is either
+ * skipped (none of the values the expression reads have changed), evaluated to the same result as
+ * before (nothing is pushed downstream), or evaluated to a new result.
+ */
+struct RecalculationStats {
+    size_t skipped = 0;
+    size_t unchanged = 0;
+    size_t changed = 0;
+
+    /**
+     * @return The total number of recalculations requested
+     */
+    size_t total() const { return skipped + unchanged + changed; }
+};
+
 /**
  * A Dependant connects something that changes (like a data-binding) to something that needs to be informed
  * when a change occurs. The upstream object normally holds an array of dependants to be recalculated.  Each
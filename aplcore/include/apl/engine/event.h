@@ -128,6 +128,24 @@ enum EventType {
      * The server must resolve the ActionRef when the scroll is completed.
      */
     kEventTypeSpeak,
+
+    /**
+     * Run an animation in the view host.  Only sent if RootConfig::offloadAnimations is enabled.
+     *
+     * The component is the component to animate.
+     * kEventPropertyDuration: The duration of a single cycle of the animation in milliseconds.
+     * kEventPropertyEasing: The easing curve applied to each cycle.
+     * kEventPropertyRepeatCount: The number of times to repeat the animation after the first cycle.
+     * kEventPropertyRepeatMode: The repeat mode (kCommandRepeatModeRestart or kCommandRepeatModeReverse).
+     * kEventPropertyValue: An array of animated properties.  Each is a map with a "property" name.
+     *   Opacity has numeric "from" and "to" values.  Transform has a "value" holding the
+     *   InterpolatedTransformation assigned to the component; interpolate it to produce each frame.
+     *
+     * The component properties hold the starting values when the event is sent.  The server must
+     * resolve the ActionRef when the animation completes; the core then assigns the final values.
+     * If the ActionRef is terminated the server should stop the animation.
+     */
+    kEventTypeAnimateItem,
 };
 
 enum EventProperty {
@@ -142,6 +160,10 @@ enum EventProperty {
     kEventPropertyPosition,
     kEventPropertySource,
     kEventPropertyValue,
+    kEventPropertyDuration,
+    kEventPropertyEasing,
+    kEventPropertyRepeatCount,
+    kEventPropertyRepeatMode,
 };
 
 enum EventDirection {
@@ -0,0 +1,79 @@
+/**
+ * Copyright 2019 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef _APL_EXPRESSION_MEMO_H
+#define _APL_EXPRESSION_MEMO_H
+
+#include <set>
+#include <string>
+#include <vector>
+
+#include "apl/primitives/object.h"
+
+namespace apl {
+
+class Context;
+
+/**
+ * Remembers the last result of a data-binding expression along with the versions of the context
+ * values the expression read to compute it.
+ *
+ * An expression that refers to several mutable values has one dependant per value, and all of the
+ * dependants that recalculate the same target share a single memo.  When a change reaches the
+ * target through more than one path (for example, "${a + b}" where b is itself bound to a) the
+ * later recalculations find their inputs unchanged and are skipped.
+ */
+class ExpressionMemo {
+public:
+    /**
+     * @param symbols The context symbols referred to by the expression.
+     */
+    explicit ExpressionMemo(const std::set<std::string>& symbols)
+        : mSymbols(symbols.begin(), symbols.end())
+    {}
+
+    /**
+     * Record the result of the initial evaluation of the expression and the current versions of
+     * its inputs.  Call this when the memo is created so the first change has a result to compare.
+     * @param context The context the expression was evaluated in.
+     * @param value The result of evaluating the expression.
+     */
+    void seed(const Context& context, const Object& value);
+
+    /**
+     * Re-evaluate the expression if any of its inputs have changed.
+     * @param context The context to evaluate the expression in.
+     * @param node The parsed expression.
+     * @return True if the expression was evaluated and the result differs from the previous result.
+     */
+    bool update(Context& context, const Object& node);
+
+    /**
+     * @return The most recently calculated result.
+     */
+    const Object& value() const { return mValue; }
+
+private:
+    bool inputsChanged(const Context& context);
+
+    std::vector<std::string> mSymbols;
+    std::vector<unsigned int> mVersions;
+    Object mValue;
+    bool mValid = false;
+};
+
+} // namespace apl
+
+#endif // _APL_EXPRESSION_MEMO_H
@@ -16,14 +16,33 @@
 #ifndef _APL_KEY_MASTER_H
 #define _APL_KEY_MASTER_H
 
+#include <map>
 #include <memory>
+#include <vector>
 
 #include "apl/primitives/keyboard.h"
+#include "apl/primitives/object.h"
 
 namespace apl {
 
+class Context;
 class CoreComponent;
 
+/**
+ * A key handler prepared for repeated dispatch.  The "when" and "propagate" clauses are
+ * parsed once.  A "when" clause that only compares event.keyboard.code with a string is
+ * matched against the key code without evaluating it at all.
+ */
+struct KeyHandler {
+    Object handler;      // The original handler definition, used for "commands"
+    Object when;         // Parsed "when" clause
+    Object propagate;    // Parsed "propagate" clause
+    std::string code;    // The key code "when" tests for, if it is a simple code test
+    bool codeOnly;       // True if "when" is exactly event.keyboard.code == code
+};
+
+using KeyHandlerList = std::vector<KeyHandler>;
+
 class KeyboardManager {
 public:
 
@@ -48,10 +67,29 @@ public:
      */
     static std::string getHandlerId(KeyHandlerType type);
 
+    /**
+     * Parse an array of key handlers for repeated dispatch.
+     * @param context The context the handlers are evaluated in, without the "event" property.
+     * @param handlers The handler definitions.
+     * @return The prepared handlers.
+     */
+    static KeyHandlerList compileKeyHandlers(const Context& context, const std::vector<Object>& handlers);
+
+    /**
+     * Find the first handler whose "when" clause is true.
+     * @param handlers The prepared handlers.
+     * @param eventContext The event context.  It must contain "event.keyboard".
+     * @param keyboard The keyboard update.
+     * @return The matching handler or nullptr.
+     */
+    static const KeyHandler* findKeyHandler(const KeyHandlerList& handlers, const Context& eventContext,
+                                            const ObjectMap& keyboard);
+
 private:
 
     bool executeDocumentKeyHandlers(const RootContextPtr& rootContext,  KeyHandlerType type, const ObjectMapPtr& keyboard);
 
+    std::map<KeyHandlerType, KeyHandlerList> mDocumentHandlers;
 };
 
 } // namespace apl
@@ -37,7 +37,7 @@ namespace apl {
 
 class Properties {
 public:
-    Properties() {}
+    Properties() : mSourcesKnown(true) {}
 
     // These methods apply data-binding and extract the value or a default value
     std::string asLabel(const Context& context, const char *name);
@@ -47,7 +47,19 @@ public:
     Dimension asAbsoluteDimension(const Context& context, const char *name, double defvalue);
 
     void emplace(const Object& item);
-    void emplace(const std::string& name, const Object& value) { mProperties.emplace(name, value); }
+    void emplace(const std::string& name, const Object& value) {
+        mProperties.emplace(name, value);
+        mSourcesKnown = false;
+    }
+
+    /**
+     * @return The JSON objects these properties were copied from, in the order they were added,
+     *         or nullptr if any property came from somewhere else.  Properties from an earlier
+     *         object take precedence.
+     */
+    const std::vector<const rapidjson::Value*>* sources() const {
+        return mSourcesKnown ? &mSources : nullptr;
+    }
 
     Object forParameter(const Context& context, const Parameter& parameter);
 
@@ -58,6 +70,8 @@ public:
 
 private:
     ObjectMap mProperties;
+    std::vector<const rapidjson::Value*> mSources;
+    bool mSourcesKnown;
 };
 
 } // namespace apl
@@ -16,6 +16,10 @@
 #ifndef _APL_PROPERTY_MAP_H
 #define _APL_PROPERTY_MAP_H
 
+#include <iterator>
+#include <map>
+#include <memory>
+
 #include "apl/utils/bimap.h"
 #include "apl/primitives/object.h"
 
@@ -23,18 +27,91 @@ namespace apl {
 
 /**
  * Store calculated values that can be accessed by either string or integer index.
+ *
+ * A property map may be layered over a shared, immutable block of default values.  Only
+ * values that differ from the defaults are stored locally; lookups and iteration see the
+ * merged result.
+ *
  * @tparam T The enumerated type stored.
  * @tparam bimap The bi-directional map.
  */
 template<class T, Bimap<int, std::string>& bimap>
 class PropertyMap {
 public:
+    using Map = std::map<T, Object>;
+    using MapPtr = std::shared_ptr<const Map>;
+
+    /**
+     * Iterate over the local values merged with the default values, in key order.
+     */
+    class const_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = typename Map::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const value_type*;
+        using reference = const value_type&;
+
+        const_iterator(typename Map::const_iterator value, typename Map::const_iterator valueEnd,
+                       typename Map::const_iterator def, typename Map::const_iterator defEnd)
+            : mValue(value), mValueEnd(valueEnd), mDefault(def), mDefaultEnd(defEnd) {}
+
+        reference operator*() const { return useValue() ? *mValue : *mDefault; }
+        pointer operator->() const { return &**this; }
+
+        const_iterator& operator++() {
+            if (useValue()) {
+                if (mDefault != mDefaultEnd && mDefault->first == mValue->first)
+                    ++mDefault;
+                ++mValue;
+            }
+            else
+                ++mDefault;
+            return *this;
+        }
+
+        bool operator==(const const_iterator& rhs) const { return mValue == rhs.mValue && mDefault == rhs.mDefault; }
+        bool operator!=(const const_iterator& rhs) const { return !(*this == rhs); }
+
+    private:
+        bool useValue() const {
+            return mValue != mValueEnd && (mDefault == mDefaultEnd || !(mDefault->first < mValue->first));
+        }
+
+        typename Map::const_iterator mValue, mValueEnd, mDefault, mDefaultEnd;
+    };
+
     PropertyMap() {}
 
+    /**
+     * Layer this map over a shared block of default values.  Local values that match
+     * the new defaults are not removed.
+     * @param defaults The default values.
+     */
+    void setDefaults(const MapPtr& defaults) { mDefaults = defaults; }
+
+    /**
+     * @return The shared default values or nullptr
+     */
+    const MapPtr& defaults() const { return mDefaults; }
+
     /**
      * @return The number of elements in the property map
      */
-    std::size_t size() const { return mValues.size(); }
+    std::size_t size() const {
+        if (!mDefaults)
+            return mValues.size();
+
+        std::size_t count = 0;
+        for (auto it = begin() ; it != end() ; ++it)
+            count++;
+        return count;
+    }
+
+    /**
+     * @return The number of values stored locally instead of in the shared defaults
+     */
+    std::size_t localSize() const { return mValues.size(); }
 
     /**
      * Return object by key lookup.
@@ -46,6 +123,12 @@ public:
         if (it != mValues.end())
             return it->second;
 
+        if (mDefaults) {
+            it = mDefaults->find(key);
+            if (it != mDefaults->end())
+                return it->second;
+        }
+
         return Object::NULL_OBJECT();
     }
 
@@ -87,9 +170,25 @@ public:
      * @param value The value
      */
     void set(T key, const Object& value) {
+        if (mDefaults) {
+            auto it = mDefaults->find(key);
+            if (it != mDefaults->end() && it->second == value) {
+                mValues.erase(key);
+                return;
+            }
+        }
+
         mValues[key] = value;
     }
 
+    /**
+     * Remove a locally stored value.  The key reverts to its default value, if any.
+     * @param key The key
+     */
+    void erase(T key) {
+        mValues.erase(key);
+    }
+
     const Object& operator[](T key) const {
         return get(key);
     }
@@ -98,11 +197,24 @@ public:
         return get(key);
     }
 
-    typename std::map<T,Object>::const_iterator begin() const { return mValues.begin(); }
-    typename std::map<T,Object>::const_iterator end() const { return mValues.end(); }
+    const_iterator begin() const {
+        const Map& defaults = mDefaults ? *mDefaults : emptyMap();
+        return const_iterator(mValues.begin(), mValues.end(), defaults.begin(), defaults.end());
+    }
+
+    const_iterator end() const {
+        const Map& defaults = mDefaults ? *mDefaults : emptyMap();
+        return const_iterator(mValues.end(), mValues.end(), defaults.end(), defaults.end());
+    }
 
 private:
-    std::map<T, Object> mValues;
+    static const Map& emptyMap() {
+        static Map sEmpty;
+        return sEmpty;
+    }
+
+    Map mValues;
+    MapPtr mDefaults;
 };
 
 } // namespace apl
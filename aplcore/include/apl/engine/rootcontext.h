@@ -21,6 +21,7 @@
 
 #include "apl/content/settings.h"
 #include "apl/common.h"
+#include "apl/engine/dependant.h"
 #include "apl/engine/event.h"
 #include "apl/engine/info.h"
 #include "apl/content/rootconfig.h"
@@ -171,6 +172,21 @@ public:
      */
     void clearDirty();
 
+    /**
+     * @return True if something that may affect the visual context has changed since the last
+     *         call to serializeVisualContext().
+     */
+    bool isVisualContextDirty() const;
+
+    /**
+     * Serialize the visual context of the document.  The visual context is cached; if nothing
+     * that affects it has changed since the last call, the cached copy is returned without
+     * recalculating visibility.
+     * @param allocator The allocator used to construct the result.
+     * @return The visual context of the top component.
+     */
+    rapidjson::Value serializeVisualContext(rapidjson::Document::AllocatorType& allocator);
+
     /**
      * Execute an externally-driven command
      * @param commands
@@ -197,6 +213,27 @@ public:
      */
     void updateTime(apl_time_t currentTime, apl_time_t localTime);
 
+    /**
+     * Move forward in time, spending at most the budget running timers.  Commands, animations
+     * and data-binding updates triggered by timers run inside those timers; any timers that
+     * do not fit in the budget are left for the next call.  Local and UTC time advance by the
+     * same amount as the elapsed time actually reached.  Timers set aside by the budget are
+     * not run by hasEvent(), isDirty() or any other call that clears pending work; calling
+     * this again with the same time continues them under a fresh budget.
+     *
+     * Only timers are time-sliced.  Dependant recalculation, component inflation and layout
+     * triggered inside a timer run to completion within that timer, and the layout pass that
+     * clears pending work is not bounded by the budget.
+     *
+     * A typical frame loop calls this with the frame time and keeps calling it on subsequent
+     * frames while it returns true.
+     *
+     * @param currentTime The time to move forward to.
+     * @param budget The wall-clock budget in milliseconds.
+     * @return True if work remains that should be processed on a later call.
+     */
+    bool updateTimeWithBudget(apl_time_t currentTime, apl_duration_t budget);
+
     /**
      * Generates a scroll event that will scroll the target component's sub bounds
      * to the correct place with the given alignment.
@@ -284,6 +321,12 @@ public:
      */
     const SessionPtr& getSession() const;
 
+    /**
+     * @return Counters describing how many data-binding recalculations were skipped, produced
+     *         an unchanged value or produced a changed value.
+     */
+    const RecalculationStats& getRecalculationStats() const;
+
     friend streamer& operator<<(streamer& os, const RootContext& root);
 
 private:
@@ -302,6 +345,9 @@ private:
     std::shared_ptr<RootContextData> mCore;  // When you die, make sure to tell the data to terminate itself.
     std::shared_ptr<TimeManager> mTimeManager;
     apl_time_t mLocalTime;  // Track the current local time
+    rapidjson::Document mVisualContext;  // Cached visual context
+    unsigned int mVisualContextGeneration;
+    bool mVisualContextValid;
 };
 
 } // namespace apl
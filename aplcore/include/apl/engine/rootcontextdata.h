@@ -20,7 +20,9 @@
 #include <string>
 #include <queue>
 
+#include "apl/engine/dependant.h"
 #include "apl/engine/event.h"
+#include "apl/component/componentprototype.h"
 #include "apl/time/sequencer.h"
 #include "apl/content/rootconfig.h"
 #include "apl/content/settings.h"
@@ -67,6 +69,7 @@ public:
     }
 
     Styles& styles() const { return *mStyles; }
+    ComponentPrototypes& componentPrototypes() { return mComponentPrototypes; }
     Sequencer& sequencer() const { return *mSequencer; }
     FocusManager& focusManager() const { return *mFocusManager; }
     HoverManager& hoverManager() const { return *mHoverManager; }
@@ -100,6 +103,31 @@ public:
      */
     void releaseScreenLock() { mScreenLockCount--; }
 
+    /**
+     * Record a change that may affect the visual context
+     */
+    void visualContextChanged() { mVisualContextGeneration++; }
+
+    /**
+     * @return A counter that changes whenever the visual context may have changed
+     */
+    unsigned int visualContextGeneration() const { return mVisualContextGeneration; }
+
+    /**
+     * Record a change to the bounds, scroll position or parent of a component
+     */
+    void layoutChanged() { mLayoutGeneration++; }
+
+    /**
+     * @return A counter that changes whenever the global position of any component may have changed
+     */
+    unsigned int layoutGeneration() const { return mLayoutGeneration; }
+
+    /**
+     * @return Counters for the dependant recalculations performed in this document
+     */
+    RecalculationStats& recalculationStats() { return mRecalculationStats; }
+
 public:
     const int pixelWidth;
     const int pixelHeight;
@@ -117,6 +145,7 @@ private:
     std::map<std::string, JsonResource> mCommands;
     std::map<std::string, JsonResource> mGraphics;
     const std::unique_ptr<Styles> mStyles;
+    ComponentPrototypes mComponentPrototypes;
     std::unique_ptr<Sequencer> mSequencer;
     std::unique_ptr<FocusManager> mFocusManager;
     std::unique_ptr<HoverManager> mHoverManager;
@@ -126,6 +155,9 @@ private:
     CoreComponentPtr mTop;         // The top component
     const RootConfig mConfig;
     int mScreenLockCount;
+    unsigned int mVisualContextGeneration;
+    unsigned int mLayoutGeneration;
+    RecalculationStats mRecalculationStats;
     Settings mSettings;
     SessionPtr mSession;
 };
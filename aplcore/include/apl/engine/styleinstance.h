@@ -17,6 +17,7 @@
 #define _APL_STYLED_H
 
 #include <map>
+#include <vector>
 
 #include "apl/primitives/object.h"
 
@@ -32,6 +33,10 @@ class Path;
  * Each named property in the style also has a provenance which is the JSON path to the content that
  * defined that particular property in the style.  The overall style also has a provenance which is the
  * JSON path to the content where the style was defined.
+ *
+ * Once constructed a StyleInstance is immutable.  The StyleDefinition flattens the inheritance chain
+ * into each instance and pre-resolves the property names that map onto component properties, so that
+ * components can restyle themselves without string lookups.
  */
 class StyleInstance {
 public:
@@ -82,13 +87,28 @@ public:
      */
     size_t size() const { return mValue.size(); }
 
+    /**
+     * @return The style properties that correspond to component properties, sorted by component
+     *         property key.  The object pointers refer to values owned by this style.
+     */
+    const std::vector<std::pair<int, const Object*>>& componentProperties() const { return mComponentProperties; }
+
+    /**
+     * Check if another style instance defines exactly the same properties and provenance.
+     * @param other The other style instance.
+     * @return True if the two style instances are interchangeable.
+     */
+    bool equivalent(const StyleInstance& other) const;
+
     friend class StyleDefinition;
 
 protected:
     void put(const std::string& key, const Object& value, const std::string& provenance);
+    void finalize();
 
 private:
     std::map<std::string, Object> mValue;
+    std::vector<std::pair<int, const Object*>> mComponentProperties;
     std::map<std::string, std::string> mProvenance;
     const std::string mStyleProvenance;
 };
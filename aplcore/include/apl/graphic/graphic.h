@@ -145,6 +145,14 @@ public:
 
     rapidjson::Value serialize(rapidjson::Document::AllocatorType& allocator) const;
 
+    /**
+     * Serialize the id and changed properties of each dirty element, ordered by element id.
+     * This does not clear the dirty flags; call clearDirty() once the changes have been applied.
+     * @param allocator RapidJSON memory allocator
+     * @return The serialized changes as an array.
+     */
+    rapidjson::Value serializeDirty(rapidjson::Document::AllocatorType& allocator) const;
+
 private:
     /**
      * Assign this graphic to a VectorGraphicComponent
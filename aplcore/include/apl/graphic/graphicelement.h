@@ -16,6 +16,7 @@
 #ifndef _APL_GRAPHIC_ELEMENT_H
 #define _APL_GRAPHIC_ELEMENT_H
 
+#include <bitset>
 #include <memory>
 #include <set>
 
@@ -33,9 +34,17 @@ namespace apl {
 
 class GraphicPropDefSet;
 
+/**
+ * Orders graphic elements by their unique id so that changes are reported in a stable order.
+ */
+struct GraphicElementIdLess {
+    bool operator()(const GraphicElementPtr& lhs, const GraphicElementPtr& rhs) const;
+};
+
 using GraphicChildren = std::vector<GraphicElementPtr>;
 using GraphicDirtyProperties = std::set<GraphicPropertyKey>;
-using GraphicDirtyChildren = std::set<GraphicElementPtr>;
+using GraphicDirtyMask = std::bitset<kGraphicPropertyKeyCount>;
+using GraphicDirtyChildren = std::set<GraphicElementPtr, GraphicElementIdLess>;
 
 using GraphicPropertyMap = PropertyMap<GraphicPropertyKey, sGraphicPropertyBimap>;
 
@@ -105,32 +114,56 @@ public:
     /**
      * Clear all properties marked as dirty.
      */
-    void clearDirtyProperties() { mDirtyProperties.clear(); }
+    void clearDirtyProperties() {
+        mDirtyProperties.clear();
+        mDirtyMask.reset();
+    }
 
     /**
      * @return The set of properties which are marked as dirty for this element.
      */
     const std::set<GraphicPropertyKey>& getDirtyProperties() const { return mDirtyProperties; }
 
+    /**
+     * @return The dirty properties of this element as a bit mask indexed by GraphicPropertyKey.
+     */
+    const GraphicDirtyMask& getDirtyMask() const { return mDirtyMask; }
+
     /**
      * @return The type of this element.
      */
     virtual GraphicElementType getType() const = 0;
 
+    /**
+     * Retrieve the parsed geometry of a path element.  The path data is parsed the first time
+     * this is called and again only when the "pathData" property changes.
+     * @return The parsed path, or nullptr if this element is not a path.
+     */
+    virtual GraphicPathPtr getPath() const { return nullptr; }
+
     rapidjson::Value serialize(rapidjson::Document::AllocatorType& allocator) const;
 
+    /**
+     * Serialize the id of this element and the values of its dirty properties.  Children are
+     * not included.
+     * @param allocator RapidJSON memory allocator
+     * @return The serialized changes.
+     */
+    rapidjson::Value serializeDirty(rapidjson::Document::AllocatorType& allocator) const;
+
 protected:
     virtual bool initialize(const ContextPtr& context, const Object& json);
     void addChildren(const GraphicPtr& graphic, const ContextPtr& context, const Object& json);
 
     virtual const GraphicPropDefSet& propDefSet() const = 0;
-    bool setValue(GraphicPropertyKey key, const Object& value, bool useDirtyFlag);
+    virtual bool setValue(GraphicPropertyKey key, const Object& value, bool useDirtyFlag);
 
 protected:
     id_type                mId;               // Unique ID assigned to this vector graphic element
     GraphicPropertyMap     mValues;           // Calculated values
     GraphicChildren        mChildren;         // Child elements
     GraphicDirtyProperties mDirtyProperties;  // Set of dirty properties
+    GraphicDirtyMask       mDirtyMask;        // Dirty properties as a bit mask
     Properties             mProperties;
     std::weak_ptr<Graphic> mGraphic;          // The top-level graphic we belong to
 };
@@ -0,0 +1,117 @@
+/**
+ * Copyright 2019 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef _APL_GRAPHIC_PATH_H
+#define _APL_GRAPHIC_PATH_H
+
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+#include "apl/primitives/point.h"
+#include "apl/primitives/rect.h"
+
+namespace apl {
+
+/**
+ * The commands stored in a parsed GraphicPath.  All coordinates are absolute.
+ */
+enum GraphicPathCommand {
+    /// Start a new sub-path.  One point.
+    kGraphicPathCommandMoveTo,
+    /// Straight line.  One point.
+    kGraphicPathCommandLineTo,
+    /// Quadratic bezier curve.  Two points: the control point and the end point.
+    kGraphicPathCommandQuadTo,
+    /// Cubic bezier curve.  Three points: two control points and the end point.
+    kGraphicPathCommandCubicTo,
+    /// Close the current sub-path.  No points.
+    kGraphicPathCommandClose
+};
+
+/**
+ * The parsed form of the "pathData" property of an AVG path element.
+ *
+ * The SVG path syntax is parsed once into a list of commands and a parallel array of
+ * coordinates.  Relative commands are converted to absolute, horizontal and vertical lines
+ * become lines, smooth curves have their reflected control point filled in, and elliptical
+ * arcs are converted to cubic bezier curves.  As with SVG, parsing stops at the first error
+ * and the path up to that point is kept.
+ *
+ * The command and coordinate arrays may be read directly by the view host.
+ */
+class GraphicPath {
+public:
+    /**
+     * Parse SVG path data.
+     * @param pathData The path data string.
+     */
+    explicit GraphicPath(const std::string& pathData);
+
+    /**
+     * @return The path commands in order.
+     */
+    const std::vector<GraphicPathCommand>& commands() const { return mCommands; }
+
+    /**
+     * @return The coordinates used by the commands, stored as x,y pairs.
+     */
+    const std::vector<float>& points() const { return mPoints; }
+
+    /**
+     * @return The bounding box of the path, including curve extrema.  The bounding box is
+     *         empty if the path has no drawing commands.
+     */
+    const Rect& bounds() const { return mBounds; }
+
+    /**
+     * @return True if the entire path data string was parsed without error.
+     */
+    bool isValid() const { return mValid; }
+
+    /**
+     * @return True if the path has no drawing commands.
+     */
+    bool empty() const { return mCommands.empty(); }
+
+    /**
+     * Flatten the path into polylines, one per sub-path.  Curves are subdivided so that no point
+     * of the polyline is further than the tolerance from the curve.
+     * @param tolerance The maximum distance between the curve and the polyline.
+     * @return The polylines.  A closed sub-path ends with a copy of its first point.
+     */
+    std::vector<std::vector<Point>> flatten(float tolerance) const;
+
+    /**
+     * @return The number of points consumed by a command.
+     */
+    static int pointCount(GraphicPathCommand command);
+
+private:
+    void addCommand(GraphicPathCommand command, std::initializer_list<Point> points);
+    void addArc(Point start, float rx, float ry, float rotation, bool largeArc, bool sweep, Point end);
+    void parse(const std::string& pathData);
+    void calculateBounds();
+
+private:
+    std::vector<GraphicPathCommand> mCommands;
+    std::vector<float> mPoints;
+    Rect mBounds;
+    bool mValid;
+};
+
+} // namespace apl
+
+#endif //_APL_GRAPHIC_PATH_H
@@ -52,7 +52,8 @@ enum GraphicPropertyKey {
     kGraphicPropertyViewportHeightOriginal,
     kGraphicPropertyViewportWidthOriginal,
     kGraphicPropertyWidthActual,
-    kGraphicPropertyWidthOriginal
+    kGraphicPropertyWidthOriginal,
+    kGraphicPropertyKeyCount    // Number of graphic properties; not a property
 };
 
 enum GraphicElementType {
@@ -245,6 +245,8 @@ public:
 
     // These methods return the actual contents of the Object
     const std::string& getString() const { assert(mType == kStringType); return mString; }
+    // Null-terminated string contents
+    const char *getStringData() const { assert(mType == kStringType); return mString.c_str(); }
     bool getBoolean() const { assert(mType == kBoolType); return mValue != 0; }
     double getDouble() const { assert(mType == kNumberType); return mValue; }
     int getInteger() const { assert(mType == kNumberType); return static_cast<int>(std::rint(mValue)); }
@@ -267,6 +269,7 @@ public:
     const MediaSource& getMediaSource() const {
         assert(mType == kMediaSourceType); return mData->getMediaSource();
     }
+    const datagrammar::Node& getNode() const;
 
     GraphicPtr getGraphic() const {
         assert(mType == kGraphicType); return mData->getGraphic();
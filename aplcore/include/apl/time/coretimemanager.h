@@ -19,7 +19,9 @@
 #include <algorithm>
 #include <vector>
 #include <limits>
+#include <unordered_map>
 
+#include "apl/animation/animationbatch.h"
 #include "apl/time/timemanager.h"
 
 namespace apl {
@@ -36,60 +38,119 @@ public:
 
     timeout_id setTimeout(Runnable func, apl_duration_t delay) override {
         timeout_id id = mNextId++;
-        mTimerHeap.emplace_back(TimeoutTuple(func, nullptr, mTime, delay, id));
+        mTimerHeap.emplace_back(TimeoutTuple(std::move(func), mTime, delay, id));
         std::push_heap(mTimerHeap.begin(), mTimerHeap.end());
         return id;
     }
 
     timeout_id setAnimator(Animator animator, apl_duration_t delay) override {
         timeout_id id = mNextId++;
-        mTimerHeap.emplace_back(TimeoutTuple(nullptr, animator, mTime, delay, id));
+        mTimerHeap.emplace_back(TimeoutTuple(nullptr, mTime, delay, id));
         std::push_heap(mTimerHeap.begin(), mTimerHeap.end());
+        mAnimatorIndex.emplace(id, mAnimators.size());
+        mAnimatorIds.push_back(id);
+        mAnimatorStart.push_back(mTime);
+        mAnimators.emplace_back(std::move(animator));
         mAnimatorCount++;
         return id;
     }
 
+    timeout_id setAnimation(const CoreComponentPtr& target,
+                            const std::vector<std::unique_ptr<AnimatedProperty>>& properties,
+                            const Easing& easing,
+                            bool reversed,
+                            apl_duration_t duration,
+                            Runnable done) override {
+        timeout_id id = mNextId++;
+        mAnimations.add(id, mTime, duration, easing, reversed, target, properties);
+
+        // The final values are applied when the timeout fires, in order with the other timers
+        auto finish = [this, id, done]() {
+            mAnimations.finish(id);
+            done();
+        };
+        mTimerHeap.emplace_back(TimeoutTuple(std::move(finish), mTime, duration, id));
+        std::push_heap(mTimerHeap.begin(), mTimerHeap.end());
+        return id;
+    }
+
     bool clearTimeout(timeout_id id) override {
         for (auto it = mTimerHeap.begin(); it != mTimerHeap.end(); it++) {
             if (it->id == id) {
-                if (it->animator)
-                    mAnimatorCount--;
+                if (!it->runnable)
+                    removeAnimator(id);
+                else
+                    mAnimations.remove(id);
                 it = mTimerHeap.erase(it);
                 std::make_heap(mTimerHeap.begin(), mTimerHeap.end());
                 return true;
             }
         }
 
+        for (auto it = mDeferred.begin(); it != mDeferred.end(); it++) {
+            if (it->id == id) {
+                if (!it->runnable)
+                    removeAnimator(id);
+                else
+                    mAnimations.remove(id);
+                mDeferred.erase(it);
+                return true;
+            }
+        }
+
         return false;
     }
 
     /****** Methods from TimeManager *******/
 
-    int size() const override { return mTimerHeap.size(); }
+    int size() const override { return mTimerHeap.size() + mDeferred.size(); }
 
     void updateTime(apl_time_t updatedTime) override {
+        runDeferred();
+
         // Block going backwards in time, but clear any pending timeouts.
         if (updatedTime <= mTime) {
             runPending();
             return;
         }
 
-        auto deltaTime = updatedTime - mTime;
-
         while (!mTimerHeap.empty() && mTimerHeap.begin()->endTime <= updatedTime)
             advanceToNext();
 
         mTime = updatedTime;
+        tickAnimators();
+    }
+
+    bool updateTimeWithDeadline(apl_time_t updatedTime,
+                                std::chrono::steady_clock::time_point deadline) override {
+        // Block going backwards in time
+        auto targetTime = std::max(updatedTime, mTime);
+
+        bool ranTimer = false;
+        while (!mDeferred.empty() || (!mTimerHeap.empty() && mTimerHeap.begin()->endTime <= targetTime)) {
+            if (ranTimer && std::chrono::steady_clock::now() >= deadline) {
+                deferDue();
+                tickAnimators();
+                return true;
+            }
 
-        // Run any animations outstanding. TODO: Could we make this more efficient by skipping non-animators?
-        for (auto& m : mTimerHeap) {
-            if (m.animator)
-                m.animator(mTime - m.startTime);
+            if (!mDeferred.empty())
+                runNextDeferred();
+            else
+                advanceToNext();
+            ranTimer = true;
         }
+
+        mTime = targetTime;
+        tickAnimators();
+        return false;
     }
 
     virtual apl_time_t nextTimeout() override {
-        if (mAnimatorCount > 0)
+        if (!mDeferred.empty())
+            return mTime;
+
+        if (mAnimatorCount > 0 || !mAnimations.empty())
             return mTime + 1;
 
         if (mTimerHeap.size())
@@ -106,40 +167,157 @@ public:
     }
 
 protected:
+    struct TimeoutTuple;
+
     void advanceToNext() {
         std::pop_heap(mTimerHeap.begin(), mTimerHeap.end());  // Move to end
-        TimeoutTuple tt = mTimerHeap.back();  // Grab the last element
+        TimeoutTuple tt = std::move(mTimerHeap.back());  // Grab the last element
         mTimerHeap.pop_back();  // Remove the last element
+        fire(tt);
+    }
+
+    void fire(TimeoutTuple& tt) {
         mTime = tt.endTime;   // Advance the clock
         if (tt.runnable)
             tt.runnable();  // Execute the runnable
         else {
-            tt.animator(tt.endTime - tt.startTime);
-            mAnimatorCount--;
+            auto animator = removeAnimator(tt.id);
+            if (animator)
+                animator(tt.endTime - tt.startTime);
         }
     }
 
+    /**
+     * Set aside the timers that are already due when a deadline stops an update.  They have
+     * reached their end time, so runPending() would otherwise run them without a deadline.
+     * They run first on the next update, in the order they would have run.
+     */
+    void deferDue() {
+        while (!mTimerHeap.empty() && mTimerHeap.begin()->endTime <= mTime) {
+            std::pop_heap(mTimerHeap.begin(), mTimerHeap.end());
+            mDeferred.emplace_back(std::move(mTimerHeap.back()));
+            mTimerHeap.pop_back();
+        }
+    }
+
+    void runNextDeferred() {
+        TimeoutTuple tt = std::move(mDeferred.front());
+        mDeferred.erase(mDeferred.begin());
+        fire(tt);
+    }
+
+    void runDeferred() {
+        while (!mDeferred.empty())
+            runNextDeferred();
+    }
+
+    /**
+     * Run every active animator for the current time.  Batched animations advance first, in a
+     * single pass over their property arrays.  The elapsed times of the remaining animators are
+     * calculated in one pass over contiguous arrays before any callback runs.  Removed animators
+     * are compacted out once the pass completes.
+     */
+    void tickAnimators() {
+        if (!mAnimations.empty())
+            mAnimations.tick(mTime);
+
+        auto count = mAnimators.size();
+        if (count == 0)
+            return;
+
+        mElapsed.resize(count);
+        for (size_t i = 0 ; i < count ; i++)
+            mElapsed[i] = mTime - mAnimatorStart[i];
+
+        // The callback is moved out while it runs because it may add animators, which can
+        // reallocate the arrays.
+        for (size_t i = 0 ; i < count ; i++) {
+            if (mAnimatorIds[i] == 0)
+                continue;
+            Animator animator = std::move(mAnimators[i]);
+            animator(mElapsed[i]);
+            if (mAnimatorIds[i] != 0)
+                mAnimators[i] = std::move(animator);
+        }
+
+        if (mAnimators.size() != static_cast<size_t>(mAnimatorCount))
+            compactAnimators();
+    }
+
+    /**
+     * Remove an animator from the active arrays.  The animator is only marked as removed, so
+     * indices stay stable while animators are running; the next tick compacts the arrays.
+     * @param id The timeout id of the animator.
+     * @return The animator function, or nullptr if it was not found.
+     */
+    Animator removeAnimator(timeout_id id) {
+        auto it = mAnimatorIndex.find(id);
+        if (it == mAnimatorIndex.end())
+            return nullptr;
+
+        auto index = it->second;
+        mAnimatorIndex.erase(it);
+        Animator animator = std::move(mAnimators[index]);
+        mAnimatorIds[index] = 0;
+        mAnimatorCount--;
+        return animator;
+    }
+
+    void compactAnimators() {
+        size_t target = 0;
+        for (size_t i = 0 ; i < mAnimators.size() ; i++) {
+            if (mAnimatorIds[i] != 0) {
+                if (target != i) {
+                    mAnimatorIds[target] = mAnimatorIds[i];
+                    mAnimatorStart[target] = mAnimatorStart[i];
+                    mAnimators[target] = std::move(mAnimators[i]);
+                    mAnimatorIndex[mAnimatorIds[target]] = target;
+                }
+                target++;
+            }
+        }
+
+        mAnimatorIds.resize(target);
+        mAnimatorStart.resize(target);
+        mAnimators.resize(target);
+    }
+
 protected:
-    // Hold regular timers until they fire
+    // Hold regular timers until they fire.  Animators are also placed here so that they finish
+    // in order with the other timers; their callbacks live in the animator arrays.
     struct TimeoutTuple {
-        TimeoutTuple(Runnable runnable, Animator animator, apl_time_t startTime, apl_duration_t duration, timeout_id id)
-            : runnable(runnable), animator(animator), startTime(startTime), endTime(startTime + duration), id(id) {}
+        TimeoutTuple(Runnable runnable, apl_time_t startTime, apl_duration_t duration, timeout_id id)
+            : runnable(std::move(runnable)), startTime(startTime), endTime(startTime + duration), id(id) {}
 
         Runnable runnable;
-        Animator animator;
         apl_time_t startTime;
         apl_time_t endTime;
         timeout_id id;
 
         bool operator<(const TimeoutTuple& rhs) const {
-            return endTime > rhs.endTime;  // Reverse the order deliberately
+            // Reverse the order deliberately.  Timers with the same end time run in the order set.
+            if (endTime != rhs.endTime)
+                return endTime > rhs.endTime;
+            return id > rhs.id;
         }
     };
 
     std::vector<TimeoutTuple> mTimerHeap;
+    std::vector<TimeoutTuple> mDeferred;    // Due timers set aside by a deadline, in order
     apl_time_t mTime;
     timeout_id mNextId;
     int mAnimatorCount;
+
+    // Batched animations of component properties
+    AnimationBatch mAnimations;
+
+    // Active animators, stored as parallel arrays in the order they were added.  A removed
+    // animator has an id of zero until the arrays are compacted.
+    std::unordered_map<timeout_id, size_t> mAnimatorIndex;
+    std::vector<timeout_id> mAnimatorIds;
+    std::vector<apl_time_t> mAnimatorStart;
+    std::vector<Animator> mAnimators;
+    std::vector<apl_duration_t> mElapsed;    // Scratch space reused on every tick
 };
 
 
@@ -20,6 +20,7 @@
 #include "apl/engine/context.h"
 #include "apl/component/corecomponent.h"
 #include "apl/command/command.h"
+#include "apl/utils/intrusivelist.h"
 
 namespace apl {
 
@@ -73,7 +74,7 @@ private:
     ActionPtr mMasterActionPtr;
     bool mTerminated;
     const std::shared_ptr<TimeManager> mTimeManager;
-    std::set<ActionPtr> mOneShotSet;
+    IntrusiveList<Action> mOneShots;   // Pending fast-mode actions
 };
 
 } // namespace apl
@@ -16,6 +16,8 @@
 #ifndef _APL_TIME_MANAGER_H
 #define _APL_TIME_MANAGER_H
 
+#include <chrono>
+
 #include "apl/common.h"
 #include "timers.h"
 
@@ -38,6 +40,23 @@ public:
      */
     virtual void updateTime(apl_time_t updatedTime) = 0;
 
+    /**
+     * Move forward in time, stopping early if the deadline passes.  At least one pending timer
+     * is run on each call.  When the deadline stops the update, the current time is left at
+     * the last timer that fired and the remaining timers run on the next call, including
+     * timers that share the end time of the last one.  runPending() does not run them.
+     *
+     * The default implementation ignores the deadline.
+     * @param updatedTime The time to move forward to.
+     * @param deadline The wall-clock time at which to stop running timers.
+     * @return True if timers up to updatedTime are still waiting to run.
+     */
+    virtual bool updateTimeWithDeadline(apl_time_t updatedTime,
+                                        std::chrono::steady_clock::time_point deadline) {
+        updateTime(updatedTime);
+        return false;
+    }
+
     /**
      * @return The time of the next timeout.  If animators are running, the
      *         next timeout is always 1 greater than the current time.
@@ -18,11 +18,16 @@
 
 #include <functional>
 #include <limits>
+#include <memory>
+#include <vector>
 
 #include "apl/common.h"
 
 namespace apl {
 
+class AnimatedProperty;
+class Easing;
+
 class Timers
 {
 public:
@@ -52,6 +57,30 @@ public:
      */
     virtual timeout_id setAnimator(Animator animator, apl_duration_t duration) = 0;
 
+    /**
+     * Animate component properties along an easing curve.  Timers that support this advance
+     * every running animation together in a single batched pass instead of calling an
+     * animator per animation.  The final values are applied when the duration elapses.
+     *
+     * The default implementation does not batch animations and returns 0; the caller should
+     * fall back to setAnimator().
+     * @param target The component being animated.
+     * @param properties The animated properties.  They are read when the animation is set.
+     * @param easing The easing curve.
+     * @param reversed If true, the animation runs from the end values to the start values.
+     * @param duration The duration of the animation.  Must be positive.
+     * @param done The function to call after the final values are applied.
+     * @return A unique ID for the animation, or 0 if animations are not batched.
+     */
+    virtual timeout_id setAnimation(const CoreComponentPtr& target,
+                                    const std::vector<std::unique_ptr<AnimatedProperty>>& properties,
+                                    const Easing& easing,
+                                    bool reversed,
+                                    apl_duration_t duration,
+                                    Runnable done) {
+        return 0;
+    }
+
     /**
      * Cancel an executing timeout function.
      * @param id The id of the timeout.
@@ -18,7 +18,10 @@
 
 #include <vector>
 #include <map>
+#include <unordered_map>
 #include <algorithm>
+#include <stdexcept>
+#include <type_traits>
 
 namespace apl {
 
@@ -44,6 +47,10 @@ namespace apl {
  *     test.at(10)      -> "dog"
  *     test.at(20)      -> "dog"
  *
+ * Lookups from "B" to "A" go through a hash table.  When "A" is an integral or
+ * enumerated type with a compact range of values, lookups from "A" to "B" index
+ * directly into a table; sparse keys fall back to the ordered map.
+ *
  * @tparam A The first type.
  * @tparam B The second type.
  */
@@ -56,33 +63,49 @@ public:
             mAtoB.emplace(m.first, m.second);
             mBtoA.emplace(m.second, m.first);
         }
+        buildIndex();
     }
 
-    const A& at(B x) const { return mBtoA.at(x); }
-    const B& at(A x) const { return mAtoB.at(x); }
+    Bimap(const Bimap& other) : mAtoB(other.mAtoB), mBtoA(other.mBtoA) { buildIndex(); }
+
+    Bimap& operator=(const Bimap& other) {
+        mAtoB = other.mAtoB;
+        mBtoA = other.mBtoA;
+        buildIndex();
+        return *this;
+    }
+
+    const A& at(const B& x) const { return mBtoA.at(x); }
+    const B& at(const A& x) const {
+        auto ptr = lookup(x);
+        if (!ptr)
+            throw std::out_of_range("Bimap::at");
+        return *ptr;
+    }
 
-    bool has(B x) const { return mBtoA.count(x); }
-    bool has(A x) const { return mAtoB.count(x); }
+    bool has(const B& x) const { return mBtoA.count(x); }
+    bool has(const A& x) const { return lookup(x) != nullptr; }
 
     std::size_t size() const { return mAtoB.size(); }
 
-    A get(B x, A defvalue) const {
+    A get(const B& x, A defvalue) const {
         auto it = mBtoA.find(x);
         return (it != mBtoA.end() ? it->second : defvalue);
     }
 
-    B get(A x, B defvalue) const {
-        auto it = mAtoB.find(x);
-        return (it != mAtoB.end() ? it->second : defvalue);
+    B get(const A& x, B defvalue) const {
+        auto ptr = lookup(x);
+        return (ptr ? *ptr : defvalue);
     }
 
     typename std::map<A,B>::const_iterator begin() const { return mAtoB.begin(); }
     typename std::map<A,B>::const_iterator end() const { return mAtoB.end(); }
 
-    typename std::map<B,A>::const_iterator beginBtoA() const { return mBtoA.begin(); }
-    typename std::map<B,A>::const_iterator endBtoA() const { return mBtoA.end(); }
+    // Iteration from "B" to "A" is in no particular order
+    typename std::unordered_map<B,A>::const_iterator beginBtoA() const { return mBtoA.begin(); }
+    typename std::unordered_map<B,A>::const_iterator endBtoA() const { return mBtoA.end(); }
 
-    A append(B b) {
+    A append(const B& b) {
         auto it = mBtoA.find(b);
         if (it != mBtoA.end())
             return it->second;
@@ -90,6 +113,7 @@ public:
         int a = maxA() + 1;
         mAtoB.emplace(a, b);
         mBtoA.emplace(b, a);
+        buildIndex();
         return a;
     }
 
@@ -100,8 +124,57 @@ public:
     }
 
 private:
+    // Only integral and enumerated "A" types can index a table
+    using Indexable = std::integral_constant<bool, std::is_integral<A>::value || std::is_enum<A>::value>;
+
+    /**
+     * Build a direct-indexed table of pointers into mAtoB.  The map nodes are stable, so the
+     * table only needs to be rebuilt when entries are added or the map is copied.  Sparse keys
+     * leave the table empty and lookups use the ordered map instead.
+     */
+    void buildIndex() {
+        mIndex.clear();
+        buildIndex(Indexable());
+    }
+
+    void buildIndex(std::false_type) {}
+
+    void buildIndex(std::true_type) {
+        if (mAtoB.empty())
+            return;
+
+        long lo = static_cast<long>(mAtoB.begin()->first);
+        long hi = static_cast<long>(mAtoB.rbegin()->first);
+        if (hi - lo >= static_cast<long>(4 * mAtoB.size() + 16))
+            return;
+
+        mIndexBase = lo;
+        mIndex.resize(hi - lo + 1, nullptr);
+        for (const auto& m : mAtoB)
+            mIndex[static_cast<long>(m.first) - lo] = &m.second;
+    }
+
+    const B* lookup(const A& x) const { return lookup(x, Indexable()); }
+
+    const B* lookup(const A& x, std::false_type) const {
+        auto it = mAtoB.find(x);
+        return (it != mAtoB.end() ? &it->second : nullptr);
+    }
+
+    const B* lookup(const A& x, std::true_type) const {
+        if (mIndex.empty())
+            return lookup(x, std::false_type());
+
+        auto offset = static_cast<long>(x) - mIndexBase;
+        if (offset < 0 || offset >= static_cast<long>(mIndex.size()))
+            return nullptr;
+        return mIndex[offset];
+    }
+
     std::map<A, B> mAtoB;
-    std::map<B, A> mBtoA;
+    std::unordered_map<B, A> mBtoA;
+    std::vector<const B*> mIndex;
+    long mIndexBase = 0;
 };
 
 } // namespace apl
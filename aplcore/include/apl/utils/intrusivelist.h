@@ -0,0 +1,133 @@
+/**
+ * Copyright 2019 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef _APL_INTRUSIVE_LIST_H
+#define _APL_INTRUSIVE_LIST_H
+
+#include <cstddef>
+#include <memory>
+
+namespace apl {
+
+template<class T> class IntrusiveList;
+
+/**
+ * The links an object needs to be stored in an IntrusiveList.  Inherit from this publicly.
+ * An object can be in at most one list at a time.
+ */
+template<class T>
+class IntrusiveListHook {
+public:
+    /**
+     * @return True if this object is currently in a list.
+     */
+    bool isLinked() const { return mLinked; }
+
+private:
+    friend class IntrusiveList<T>;
+
+    std::shared_ptr<T> mNext;
+    T *mPrev = nullptr;
+    bool mLinked = false;
+};
+
+/**
+ * A doubly-linked list that threads through its elements instead of allocating a node for each
+ * one.  The list holds a strong reference to every element, so adding and removing an element
+ * never allocates and removal by pointer is constant time.
+ *
+ * @tparam T The element type.  Must inherit from IntrusiveListHook<T>.
+ */
+template<class T>
+class IntrusiveList {
+public:
+    IntrusiveList() = default;
+    IntrusiveList(const IntrusiveList&) = delete;
+    IntrusiveList& operator=(const IntrusiveList&) = delete;
+
+    ~IntrusiveList() { clear(); }
+
+    /**
+     * Add an element to the end of the list.  Elements already in a list are ignored.
+     * @param item The element.
+     * @return True if the element was added.
+     */
+    bool push_back(const std::shared_ptr<T>& item) {
+        if (!item || item->IntrusiveListHook<T>::mLinked)
+            return false;
+
+        item->IntrusiveListHook<T>::mLinked = true;
+        item->IntrusiveListHook<T>::mPrev = mTail;
+        if (mTail)
+            mTail->IntrusiveListHook<T>::mNext = item;
+        else
+            mHead = item;
+        mTail = item.get();
+        mSize++;
+        return true;
+    }
+
+    /**
+     * Remove an element from the list.
+     * @param item The element.
+     * @return True if the element was in the list.
+     */
+    bool remove(T *item) {
+        if (!item || !item->IntrusiveListHook<T>::mLinked)
+            return false;
+
+        auto& hook = static_cast<IntrusiveListHook<T>&>(*item);
+        auto prev = hook.mPrev;
+        auto& owner = prev ? prev->IntrusiveListHook<T>::mNext : mHead;
+        auto keep = std::move(owner);    // Keep the element alive until it is unlinked
+
+        owner = std::move(hook.mNext);
+        if (owner)
+            owner->IntrusiveListHook<T>::mPrev = prev;
+        else
+            mTail = prev;
+
+        hook.mPrev = nullptr;
+        hook.mLinked = false;
+        mSize--;
+        return true;
+    }
+
+    /**
+     * Remove every element.  Elements are released in order without recursing down the list.
+     */
+    void clear() {
+        while (mHead) {
+            auto item = std::move(mHead);
+            mHead = std::move(item->IntrusiveListHook<T>::mNext);
+            item->IntrusiveListHook<T>::mPrev = nullptr;
+            item->IntrusiveListHook<T>::mLinked = false;
+        }
+        mTail = nullptr;
+        mSize = 0;
+    }
+
+    bool empty() const { return mSize == 0; }
+    size_t size() const { return mSize; }
+
+private:
+    std::shared_ptr<T> mHead;
+    T *mTail = nullptr;
+    size_t mSize = 0;
+};
+
+} // namespace apl
+
+#endif //_APL_INTRUSIVE_LIST_H
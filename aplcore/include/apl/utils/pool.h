@@ -0,0 +1,148 @@
+/**
+ * Copyright 2019 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef _APL_POOL_H
+#define _APL_POOL_H
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace apl {
+
+/**
+ * A per-thread free list of memory blocks of a single size.  Released blocks are kept for reuse
+ * up to a fixed limit; beyond that they are returned to the heap.  The blocks on the list are
+ * freed when the thread exits.
+ *
+ * @tparam Size The size of each block in bytes.
+ */
+template<size_t Size>
+class PoolFreeList {
+public:
+    static constexpr size_t MAX_FREE = 256;
+
+    static void *allocate() {
+        auto& list = freeList();
+        if (list.head) {
+            auto node = list.head;
+            list.head = node->next;
+            list.count--;
+            return node;
+        }
+
+        return ::operator new(sizeof(Node) > Size ? sizeof(Node) : Size);
+    }
+
+    static void release(void *ptr) {
+        auto& list = freeList();
+        if (list.closed || list.count >= MAX_FREE) {
+            ::operator delete(ptr);
+            return;
+        }
+
+        auto node = static_cast<Node *>(ptr);
+        node->next = list.head;
+        list.head = node;
+        list.count++;
+    }
+
+    /**
+     * @return The number of blocks waiting for reuse on this thread.
+     */
+    static size_t available() { return sList.count; }
+
+private:
+    struct Node {
+        Node *next;
+    };
+
+    // Trivially destructible, so it may still be used by objects destroyed after the drain
+    struct List {
+        Node *head;
+        size_t count;
+        bool closed;
+    };
+
+    struct Drain {
+        ~Drain() {
+            auto& list = sList;
+            list.closed = true;
+            while (list.head) {
+                auto node = list.head;
+                list.head = node->next;
+                ::operator delete(node);
+            }
+            list.count = 0;
+        }
+    };
+
+    static List& freeList() {
+        static thread_local Drain sDrain;
+        (void) sDrain;  // Constructing the drain registers its destructor for thread exit
+        return sList;
+    }
+
+    static thread_local List sList;
+};
+
+template<size_t Size> thread_local typename PoolFreeList<Size>::List PoolFreeList<Size>::sList;
+
+/**
+ * An allocator that draws single objects from a PoolFreeList.  Use it with std::allocate_shared
+ * so that the object and its control block come from the pool in one block.
+ */
+template<class T>
+class PoolAllocator {
+public:
+    using value_type = T;
+
+    static_assert(alignof(T) <= alignof(std::max_align_t), "Pooled types must not be over-aligned");
+
+    PoolAllocator() = default;
+    template<class U> PoolAllocator(const PoolAllocator<U>&) {}
+
+    T *allocate(size_t n) {
+        if (n != 1)
+            return static_cast<T *>(::operator new(n * sizeof(T)));
+        return static_cast<T *>(PoolFreeList<sizeof(T)>::allocate());
+    }
+
+    void deallocate(T *ptr, size_t n) {
+        if (n != 1)
+            ::operator delete(ptr);
+        else
+            PoolFreeList<sizeof(T)>::release(ptr);
+    }
+
+    template<class U> bool operator==(const PoolAllocator<U>&) const { return true; }
+    template<class U> bool operator!=(const PoolAllocator<U>&) const { return false; }
+};
+
+/**
+ * Construct a shared object whose memory comes from a per-thread pool.  Short-lived objects that
+ * are created over and over, such as command actions, reuse the same blocks instead of going
+ * back to the heap each time.
+ */
+template<class T, class... Args>
+std::shared_ptr<T> makePooled(Args&&... args)
+{
+    return std::allocate_shared<T>(PoolAllocator<T>(), std::forward<Args>(args)...);
+}
+
+} // namespace apl
+
+#endif //_APL_POOL_H
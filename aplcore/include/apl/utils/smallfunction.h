@@ -0,0 +1,197 @@
+/**
+ * Copyright 2019 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef _APL_SMALL_FUNCTION_H
+#define _APL_SMALL_FUNCTION_H
+
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace apl {
+
+template<typename Signature, size_t Capacity = 4 * sizeof(void *)>
+class SmallFunction;
+
+/**
+ * A copyable function wrapper, like std::function, that stores callables of up to Capacity bytes
+ * inside the wrapper.  std::function only avoids the heap for trivially copyable callables of
+ * two pointers or less, so a lambda that captures a std::weak_ptr allocates every time it is
+ * wrapped.  Larger callables, and those that may throw when moved, are still stored on the heap.
+ *
+ * @tparam R The return type.
+ * @tparam Args The argument types.
+ * @tparam Capacity The inline storage in bytes.
+ */
+template<typename R, typename... Args, size_t Capacity>
+class SmallFunction<R(Args...), Capacity> {
+public:
+    SmallFunction() noexcept : mOps(nullptr) {}
+    SmallFunction(std::nullptr_t) noexcept : mOps(nullptr) {}
+
+    template<typename F,
+             typename = typename std::enable_if<
+                 !std::is_same<typename std::decay<F>::type, SmallFunction>::value &&
+                 std::is_convertible<decltype(std::declval<typename std::decay<F>::type&>()(std::declval<Args>()...)), R>::value
+             >::type>
+    SmallFunction(F&& f) : mOps(nullptr) {
+        using Functor = typename std::decay<F>::type;
+        if (isEmpty(f))
+            return;
+
+        if (Stored<Functor>::INLINE)
+            new (&mStorage) Functor(std::forward<F>(f));
+        else
+            *reinterpret_cast<Functor **>(&mStorage) = new Functor(std::forward<F>(f));
+        mOps = &Stored<Functor>::OPS;
+    }
+
+    SmallFunction(const SmallFunction& other) : mOps(other.mOps) {
+        if (mOps)
+            mOps->copy(&mStorage, &other.mStorage);
+    }
+
+    SmallFunction(SmallFunction&& other) noexcept : mOps(other.mOps) {
+        if (mOps) {
+            mOps->move(&mStorage, &other.mStorage);
+            other.mOps = nullptr;
+        }
+    }
+
+    ~SmallFunction() { reset(); }
+
+    SmallFunction& operator=(const SmallFunction& other) {
+        if (this != &other) {
+            SmallFunction tmp(other);
+            *this = std::move(tmp);
+        }
+        return *this;
+    }
+
+    SmallFunction& operator=(SmallFunction&& other) noexcept {
+        if (this != &other) {
+            reset();
+            if (other.mOps) {
+                other.mOps->move(&mStorage, &other.mStorage);
+                mOps = other.mOps;
+                other.mOps = nullptr;
+            }
+        }
+        return *this;
+    }
+
+    SmallFunction& operator=(std::nullptr_t) noexcept {
+        reset();
+        return *this;
+    }
+
+    explicit operator bool() const noexcept { return mOps != nullptr; }
+
+    R operator()(Args... args) const {
+        if (!mOps)
+            throw std::bad_function_call();
+        return mOps->invoke(const_cast<void *>(static_cast<const void *>(&mStorage)), std::forward<Args>(args)...);
+    }
+
+    friend bool operator==(const SmallFunction& f, std::nullptr_t) noexcept { return !f; }
+    friend bool operator==(std::nullptr_t, const SmallFunction& f) noexcept { return !f; }
+    friend bool operator!=(const SmallFunction& f, std::nullptr_t) noexcept { return static_cast<bool>(f); }
+    friend bool operator!=(std::nullptr_t, const SmallFunction& f) noexcept { return static_cast<bool>(f); }
+
+private:
+    using Storage = typename std::aligned_storage<Capacity, alignof(std::max_align_t)>::type;
+
+    struct Ops {
+        R (*invoke)(void *storage, Args&&... args);
+        void (*copy)(void *dst, const void *src);
+        void (*move)(void *dst, void *src);    // Leaves src destroyed
+        void (*destroy)(void *storage);
+    };
+
+    template<typename Functor>
+    struct Stored {
+        static constexpr bool INLINE = sizeof(Functor) <= Capacity &&
+                                       alignof(Functor) <= alignof(Storage) &&
+                                       std::is_nothrow_move_constructible<Functor>::value;
+
+        static Functor *get(void *storage) {
+            return INLINE ? static_cast<Functor *>(storage) : *static_cast<Functor **>(storage);
+        }
+
+        static const Functor *get(const void *storage) {
+            return INLINE ? static_cast<const Functor *>(storage) : *static_cast<Functor * const *>(storage);
+        }
+
+        static R invoke(void *storage, Args&&... args) {
+            return (*get(storage))(std::forward<Args>(args)...);
+        }
+
+        static void copy(void *dst, const void *src) {
+            if (INLINE)
+                new (dst) Functor(*get(src));
+            else
+                *static_cast<Functor **>(dst) = new Functor(*get(src));
+        }
+
+        static void move(void *dst, void *src) {
+            if (INLINE) {
+                auto f = get(src);
+                new (dst) Functor(std::move(*f));
+                f->~Functor();
+            }
+            else
+                *static_cast<Functor **>(dst) = *static_cast<Functor **>(src);
+        }
+
+        static void destroy(void *storage) {
+            if (INLINE)
+                get(storage)->~Functor();
+            else
+                delete get(storage);
+        }
+
+        static const Ops OPS;
+    };
+
+    template<typename F> static bool isEmpty(const F&) { return false; }
+    template<typename S> static bool isEmpty(const std::function<S>& f) { return !f; }
+    template<typename S> static bool isEmpty(S *f) { return f == nullptr; }
+
+    void reset() noexcept {
+        if (mOps) {
+            mOps->destroy(&mStorage);
+            mOps = nullptr;
+        }
+    }
+
+    Storage mStorage;
+    const Ops *mOps;
+};
+
+template<typename R, typename... Args, size_t Capacity>
+template<typename Functor>
+const typename SmallFunction<R(Args...), Capacity>::Ops
+SmallFunction<R(Args...), Capacity>::Stored<Functor>::OPS = {
+    &Stored<Functor>::invoke,
+    &Stored<Functor>::copy,
+    &Stored<Functor>::move,
+    &Stored<Functor>::destroy
+};
+
+} // namespace apl
+
+#endif //_APL_SMALL_FUNCTION_H
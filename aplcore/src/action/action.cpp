@@ -18,6 +18,7 @@
 #include "apl/action/action.h"
 #include "apl/time/timers.h"
 #include "apl/utils/log.h"
+#include "apl/utils/pool.h"
 
 namespace apl {
 
@@ -33,8 +34,7 @@ Action::Action(const TimersPtr& timers, TerminateFunc terminate)
       mTimers(timers),
       mArgument({.arg = 0})
 {
-    if (terminate)
-        mTerminate.push_back(terminate);
+    mTerminate = std::move(terminate);
 
     LOG_IF(DEBUG_ACTION) << "Creating action " << *this;
 }
@@ -69,7 +69,9 @@ Action::terminate()
             mTimeoutId = 0;
         }
 
-        for (const auto& f : mTerminate)
+        if (mTerminate)
+            mTerminate(mTimers);
+        for (const auto& f : mMoreTerminate)
             f(mTimers);
     }
 }
@@ -114,7 +116,10 @@ Action::resolve(const Rect& argument) {
 void
 Action::addTerminateCallback(TerminateFunc f)
 {
-    mTerminate.push_back(f);
+    if (!mTerminate)
+        mTerminate = std::move(f);
+    else
+        mMoreTerminate.push_back(std::move(f));
 }
 
 void
@@ -139,7 +144,7 @@ Action::doResolve()
 ActionPtr
 Action::make(const TimersPtr& timers, StartFunc func)
 {
-    auto ptr = std::make_shared<Action>(timers);
+    auto ptr = makePooled<Action>(timers);
     if (func)
         func(ptr);
     else
@@ -157,16 +162,22 @@ Action::makeDelayed(const TimersPtr& timers, apl_duration_t delay, StartFunc fun
     if (delay == 0)
         return make(timers, func);
 
-    auto ptr = std::make_shared<Action>(timers);
+    auto ptr = makePooled<Action>(timers);
     auto self = ptr.get();
 
+    // Without a starting function the timer closure fits in the runnable's inline storage
+    if (!func) {
+        ptr->mTimeoutId = timers->setTimeout([self]() {
+            self->mTimeoutId = 0;
+            self->resolve();
+        }, delay);
+        return ptr;
+    }
+
     ptr->mTimeoutId = timers->setTimeout([func, self]() {
         self->mTimeoutId = 0;
         if (self->isPending()) {
-            if (func)
-                func(self->shared_from_this());
-            else
-                self->resolve();
+            func(self->shared_from_this());
         }
     }, delay);
 
@@ -181,7 +192,7 @@ Action::makeAnimation(const TimersPtr& timers, apl_duration_t delay, Timers::Ani
         return make(timers);  // Return a resolved action
     }
 
-    auto ptr = std::make_shared<Action>(timers);
+    auto ptr = makePooled<Action>(timers);
     auto self = ptr.get();
 
     ptr->mTimeoutId = timers->setAnimator([delay, animator, self](apl_duration_t currentDelay) {
@@ -201,6 +212,25 @@ Action::makeAnimation(const TimersPtr& timers, apl_duration_t delay, Timers::Ani
     return ptr;
 }
 
+ActionPtr
+Action::makeAnimation(const TimersPtr& timers,
+                      apl_duration_t duration,
+                      const CoreComponentPtr& target,
+                      const std::vector<std::unique_ptr<AnimatedProperty>>& properties,
+                      const Easing& easing,
+                      bool reversed)
+{
+    auto ptr = makePooled<Action>(timers);
+    auto self = ptr.get();
+
+    ptr->mTimeoutId = timers->setAnimation(target, properties, easing, reversed, duration, [self]() {
+        self->mTimeoutId = 0;
+        self->resolve();
+    });
+
+    return ptr->mTimeoutId ? ptr : nullptr;
+}
+
 
 class Collection : public Action {
 protected:
@@ -251,7 +281,7 @@ public:
 ActionPtr
 Action::makeAll(const TimersPtr& timers, const ActionList &actionList)
 {
-    auto ptr = std::make_shared<Collection>(timers, actionList);
+    auto ptr = makePooled<Collection>(timers, actionList);
     if (ptr->size() == 0)
         return make(timers);
 
@@ -273,7 +303,7 @@ Action::makeAll(const TimersPtr& timers, const ActionList &actionList)
 ActionPtr
 Action::makeAny(const TimersPtr& timers, const ActionList &actionList)
 {
-    auto ptr = std::make_shared<Collection>(timers, actionList);
+    auto ptr = makePooled<Collection>(timers, actionList);
     if (ptr->size() == 0)
         return make(timers);
 
@@ -16,6 +16,7 @@
 #include "apl/action/animateitemaction.h"
 #include "apl/command/corecommand.h"
 #include "apl/content/rootconfig.h"
+#include "apl/engine/event.h"
 
 namespace apl {
 
@@ -65,7 +66,10 @@ AnimateItemAction::start()
         finalize();
     });
 
-    advance();
+    if (mCommand->context()->getRootConfig().getOffloadAnimations())
+        offload();
+    else
+        advance();
 }
 
 /**
@@ -87,18 +91,20 @@ AnimateItemAction::advance() {
         m->update(mCommand->target(), mReversed ? 1 : 0);
 
     std::weak_ptr<AnimateItemAction> weak_ptr(std::static_pointer_cast<AnimateItemAction>(shared_from_this()));
-    mCurrentAction = Action::makeAnimation(timers(), mDuration,
-                                           [weak_ptr](apl_duration_t offset) {
-                                               auto self = weak_ptr.lock();
-                                               if (self && !self->isTerminated()) {
-                                                   float alpha = offset / self->mDuration;
-                                                   if (self->mReversed)
-                                                       alpha = 1 - alpha;
-                                                   alpha = self->mEasing(alpha);
-                                                   for (auto& m : self->mAnimators)
-                                                       m->update(self->mCommand->target(), alpha);
-                                               }
-                                           });
+    mCurrentAction = Action::makeAnimation(timers(), mDuration, mCommand->target(), mAnimators, mEasing, mReversed);
+    if (!mCurrentAction)
+        mCurrentAction = Action::makeAnimation(timers(), mDuration,
+                                               [weak_ptr](apl_duration_t offset) {
+                                                   auto self = weak_ptr.lock();
+                                                   if (self && !self->isTerminated()) {
+                                                       float alpha = offset / self->mDuration;
+                                                       if (self->mReversed)
+                                                           alpha = 1 - alpha;
+                                                       alpha = self->mEasing(alpha);
+                                                       for (auto& m : self->mAnimators)
+                                                           m->update(self->mCommand->target(), alpha);
+                                                   }
+                                               });
 
     mCurrentAction->then([weak_ptr](const ActionPtr& ptr) {
         auto self = weak_ptr.lock();
@@ -112,6 +118,45 @@ AnimateItemAction::advance() {
     mRepeatCounter++;
 }
 
+/**
+ * Hand the entire animation (all repeats) to the view host.  The component properties are set
+ * to their starting values; the final values are assigned when the view host resolves the event.
+ */
+void
+AnimateItemAction::offload()
+{
+    auto target = mCommand->target();
+    std::vector<Object> values;
+    for (auto& m : mAnimators) {
+        m->update(target, 0);
+        values.emplace_back(m->describe());
+    }
+
+    EventBag bag;
+    bag.emplace(kEventPropertyDuration, mDuration);
+    bag.emplace(kEventPropertyEasing, mCommand->getValue(kCommandPropertyEasing));
+    bag.emplace(kEventPropertyRepeatCount, mRepeatCount);
+    bag.emplace(kEventPropertyRepeatMode, mRepeatMode);
+    bag.emplace(kEventPropertyValue, Object(std::move(values)));
+
+    auto context = mCommand->context();
+    mCurrentAction = Action::make(timers(), [&](ActionRef ref) {
+        context->pushEvent(Event(kEventTypeAnimateItem, std::move(bag), target, ref));
+    });
+
+    std::weak_ptr<AnimateItemAction> weak_ptr(std::static_pointer_cast<AnimateItemAction>(shared_from_this()));
+    mCurrentAction->then([weak_ptr](const ActionPtr& ptr) {
+        auto self = weak_ptr.lock();
+        if (self) {
+            self->mCurrentAction = nullptr;
+            if (!self->isTerminated()) {
+                self->finalize();
+                self->resolve();
+            }
+        }
+    });
+}
+
 void
 AnimateItemAction::finalize()
 {
@@ -14,6 +14,7 @@
  */
 
 #include "apl/animation/animatedproperty.h"
+#include "apl/animation/animationbatch.h"
 #include "apl/component/corecomponent.h"
 #include "apl/engine/evaluate.h"
 #include "apl/engine/arrayify.h"
@@ -93,6 +94,20 @@ AnimatedDouble::update(const CoreComponentPtr& component, float alpha) {
     component->setProperty(mKey, value);
 }
 
+void
+AnimatedDouble::addTo(AnimationBatch& batch) const {
+    batch.addDouble(mKey, mFrom, mTo);
+}
+
+Object
+AnimatedDouble::describe() const {
+    auto map = std::make_shared<ObjectMap>();
+    map->emplace("property", sComponentPropertyBimap.at(mKey));
+    map->emplace("from", mFrom);
+    map->emplace("to", mTo);
+    return Object(map);
+}
+
 AnimatedTransform::AnimatedTransform(const std::shared_ptr<InterpolatedTransformation>& transformation)
     : mTransformation(transformation)
 {
@@ -100,13 +115,33 @@ AnimatedTransform::AnimatedTransform(const std::shared_ptr<InterpolatedTransform
 
 void
 AnimatedTransform::update(const CoreComponentPtr& component, float alpha) {
-    bool changed = mTransformation->interpolate(alpha);
+    apply(component, mTransformation, alpha);
+}
+
+void
+AnimatedTransform::addTo(AnimationBatch& batch) const {
+    batch.addTransform(mTransformation);
+}
+
+void
+AnimatedTransform::apply(const CoreComponentPtr& component,
+                         const std::shared_ptr<InterpolatedTransformation>& transformation,
+                         float alpha) {
+    bool changed = transformation->interpolate(alpha);
     auto assigned = component->getCalculated(kPropertyTransformAssigned);
-    if (!assigned.isTransform() || assigned.getTransformation() != mTransformation)
-        component->setProperty(kPropertyTransformAssigned, Object(mTransformation));
+    if (!assigned.isTransform() || assigned.getTransformation() != transformation)
+        component->setProperty(kPropertyTransformAssigned, Object(transformation));
     else if (changed)
         component->markProperty(kPropertyTransformAssigned);
 }
 
+Object
+AnimatedTransform::describe() const {
+    auto map = std::make_shared<ObjectMap>();
+    map->emplace("property", sComponentPropertyBimap.at(kPropertyTransformAssigned));
+    map->emplace("value", Object(std::static_pointer_cast<Transformation>(mTransformation)));
+    return Object(map);
+}
+
 
 } // namespace apl
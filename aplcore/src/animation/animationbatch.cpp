@@ -0,0 +1,277 @@
+/**
+ * Copyright 2019 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include "apl/animation/animationbatch.h"
+#include "apl/animation/animatedproperty.h"
+#include "apl/component/corecomponent.h"
+
+namespace apl {
+
+void
+AnimationBatch::Tracks::push(timeout_id trackId, apl_time_t trackStart, float trackDuration, bool trackReversed,
+                             uint32_t trackEasing, const CoreComponentPtr& trackTarget)
+{
+    id.push_back(trackId);
+    start.push_back(trackStart);
+    duration.push_back(trackDuration);
+    reversed.push_back(trackReversed ? 1 : 0);
+    easing.push_back(trackEasing);
+    target.emplace_back(trackTarget);
+}
+
+void
+AnimationBatch::Tracks::move(size_t from, size_t to)
+{
+    id[to] = id[from];
+    start[to] = start[from];
+    duration[to] = duration[from];
+    reversed[to] = reversed[from];
+    easing[to] = easing[from];
+    target[to] = std::move(target[from]);
+}
+
+void
+AnimationBatch::Tracks::resize(size_t size)
+{
+    id.resize(size);
+    start.resize(size);
+    duration.resize(size);
+    reversed.resize(size);
+    easing.resize(size);
+    target.resize(size);
+}
+
+void
+AnimationBatch::add(timeout_id id,
+                    apl_time_t start,
+                    apl_duration_t duration,
+                    const Easing& easing,
+                    bool reversed,
+                    const CoreComponentPtr& target,
+                    const std::vector<std::unique_ptr<AnimatedProperty>>& properties)
+{
+    assert(duration > 0);
+
+    mAddId = id;
+    mAddStart = start;
+    mAddDuration = duration;
+    mAddReversed = reversed;
+    mAddEasing = easingIndex(easing);
+    mAddTarget = target;
+
+    mAnimations[id] = { mDoubles.size(), 0, mTransforms.size(), 0 };
+    for (const auto& m : properties)
+        m->addTo(*this);
+
+    mAddTarget = nullptr;
+}
+
+void
+AnimationBatch::addDouble(PropertyKey key, double from, double to)
+{
+    mDoubles.push(mAddId, mAddStart, mAddDuration, mAddReversed, mAddEasing, mAddTarget);
+    mDoubles.key.push_back(key);
+    mDoubles.from.push_back(from);
+    mDoubles.to.push_back(to);
+    mAnimations.at(mAddId).doubleCount++;
+}
+
+void
+AnimationBatch::addTransform(const std::shared_ptr<InterpolatedTransformation>& transformation)
+{
+    mTransforms.push(mAddId, mAddStart, mAddDuration, mAddReversed, mAddEasing, mAddTarget);
+    mTransforms.transformation.push_back(transformation);
+    mAnimations.at(mAddId).transformCount++;
+}
+
+bool
+AnimationBatch::remove(timeout_id id)
+{
+    auto it = mAnimations.find(id);
+    if (it == mAnimations.end())
+        return false;
+
+    // Mark the tracks as removed.  They stay in place until the next tick so that the
+    // indices of a tick in progress remain valid.
+    const auto& animation = it->second;
+    for (size_t i = animation.doubleOffset ; i < animation.doubleOffset + animation.doubleCount ; i++) {
+        mDoubles.id[i] = 0;
+        mDoubles.target[i].reset();
+    }
+
+    for (size_t i = animation.transformOffset ; i < animation.transformOffset + animation.transformCount ; i++) {
+        mTransforms.id[i] = 0;
+        mTransforms.target[i].reset();
+        mTransforms.transformation[i] = nullptr;
+    }
+
+    mRemoved += animation.doubleCount + animation.transformCount;
+    mAnimations.erase(it);
+    return true;
+}
+
+void
+AnimationBatch::finish(timeout_id id)
+{
+    auto it = mAnimations.find(id);
+    if (it == mAnimations.end())
+        return;
+
+    // The easing curve is not evaluated at the end points
+    auto animation = it->second;
+    for (size_t i = animation.doubleOffset ; i < animation.doubleOffset + animation.doubleCount ; i++) {
+        auto target = mDoubles.target[i].lock();
+        if (target)
+            target->setProperty(mDoubles.key[i], mDoubles.reversed[i] ? mDoubles.from[i] : mDoubles.to[i]);
+    }
+
+    for (size_t i = animation.transformOffset ; i < animation.transformOffset + animation.transformCount ; i++) {
+        auto target = mTransforms.target[i].lock();
+        if (target)
+            AnimatedTransform::apply(target, mTransforms.transformation[i], mTransforms.reversed[i] ? 0 : 1);
+    }
+
+    remove(id);
+}
+
+void
+AnimationBatch::tick(apl_time_t time)
+{
+    if (mRemoved)
+        compact();
+
+    // Tracks added while the values are applied wait for the next tick
+    auto doubleCount = mDoubles.size();
+    auto transformCount = mTransforms.size();
+
+    ease(mDoubles, doubleCount, time);
+    ease(mTransforms, transformCount, time);
+
+    mDoubles.value.resize(doubleCount);
+    for (size_t i = 0 ; i < doubleCount ; i++) {
+        auto alpha = mDoubles.eased[i];
+        mDoubles.value[i] = mDoubles.from[i] * (1 - alpha) + mDoubles.to[i] * alpha;
+    }
+
+    // Applying a value may remove animations, which marks their tracks with a zero id
+    for (size_t i = 0 ; i < doubleCount ; i++) {
+        if (mDoubles.id[i] == 0)
+            continue;
+        auto target = mDoubles.target[i].lock();
+        if (target)
+            target->setProperty(mDoubles.key[i], mDoubles.value[i]);
+    }
+
+    for (size_t i = 0 ; i < transformCount ; i++) {
+        if (mTransforms.id[i] == 0)
+            continue;
+        auto target = mTransforms.target[i].lock();
+        if (target)
+            AnimatedTransform::apply(target, mTransforms.transformation[i], mTransforms.eased[i]);
+    }
+}
+
+/**
+ * Calculate the eased alpha of the first "count" tracks.  Tracks from the same animation are
+ * adjacent and most animations share a few cached easing curves, so each run of tracks with
+ * the same curve is evaluated in a single batched call.
+ */
+void
+AnimationBatch::ease(Tracks& tracks, size_t count, apl_time_t time)
+{
+    tracks.alpha.resize(count);
+    tracks.eased.resize(count);
+
+    for (size_t i = 0 ; i < count ; i++) {
+        float alpha = (time - tracks.start[i]) / tracks.duration[i];
+        alpha = std::max(0.0f, std::min(1.0f, alpha));
+        tracks.alpha[i] = tracks.reversed[i] ? 1 - alpha : alpha;
+    }
+
+    size_t first = 0;
+    while (first < count) {
+        auto last = first + 1;
+        while (last < count && tracks.easing[last] == tracks.easing[first])
+            last++;
+        mEasings[tracks.easing[first]].calc(&tracks.alpha[first], &tracks.eased[first], last - first);
+        first = last;
+    }
+
+    // Easing curves always start at 0 and end at 1
+    for (size_t i = 0 ; i < count ; i++) {
+        auto alpha = tracks.alpha[i];
+        if (alpha <= 0 || alpha >= 1)
+            tracks.eased[i] = alpha;
+    }
+}
+
+void
+AnimationBatch::compact()
+{
+    size_t target = 0;
+    for (size_t i = 0 ; i < mDoubles.size() ; i++) {
+        if (mDoubles.id[i] == 0)
+            continue;
+        if (target != i) {
+            mDoubles.move(i, target);
+            mDoubles.key[target] = mDoubles.key[i];
+            mDoubles.from[target] = mDoubles.from[i];
+            mDoubles.to[target] = mDoubles.to[i];
+        }
+        if (target == 0 || mDoubles.id[target] != mDoubles.id[target - 1])
+            mAnimations.at(mDoubles.id[target]).doubleOffset = target;
+        target++;
+    }
+
+    mDoubles.resize(target);
+    mDoubles.key.resize(target);
+    mDoubles.from.resize(target);
+    mDoubles.to.resize(target);
+
+    target = 0;
+    for (size_t i = 0 ; i < mTransforms.size() ; i++) {
+        if (mTransforms.id[i] == 0)
+            continue;
+        if (target != i) {
+            mTransforms.move(i, target);
+            mTransforms.transformation[target] = std::move(mTransforms.transformation[i]);
+        }
+        if (target == 0 || mTransforms.id[target] != mTransforms.id[target - 1])
+            mAnimations.at(mTransforms.id[target]).transformOffset = target;
+        target++;
+    }
+
+    mTransforms.resize(target);
+    mTransforms.transformation.resize(target);
+
+    // Forget easing curves once no animation uses them
+    if (mAnimations.empty())
+        mEasings.clear();
+
+    mRemoved = 0;
+}
+
+uint32_t
+AnimationBatch::easingIndex(const Easing& easing)
+{
+    for (size_t i = 0 ; i < mEasings.size() ; i++)
+        if (mEasings[i] == easing)
+            return i;
+
+    mEasings.emplace_back(easing);
+    return mEasings.size() - 1;
+}
+
+} // namespace apl
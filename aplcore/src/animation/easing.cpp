@@ -128,6 +128,11 @@ Easing::operator()(float time) {
     return mLastValue;
 }
 
+void
+Easing::calc(const float *time, float *out, size_t n) const {
+    mCurve->calc(time, out, n);
+}
+
 bool
 Easing::operator==(const Easing& rhs)
 {
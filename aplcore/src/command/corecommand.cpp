@@ -174,13 +174,15 @@ CoreCommand::calculateProperties()
 
     // Update the context to include the target component properties
     // This is cheating a bit - we access the OLD context and update the items
-    // We can get away with this because the old event information will be thrown away
+    // We can get away with this because the old event information will be thrown away.
+    // Handlers whose commands never read "event" run without one.
     ObjectMap *eventMap = nullptr;
     if (mTarget) {
         auto event = mContext->opt("event");
-        assert(event.isMap());
-        eventMap = &const_cast<ObjectMap&>(event.getMap());
-        eventMap->emplace("target", mTarget->getEventTargetProperties());
+        if (event.isMap()) {
+            eventMap = &const_cast<ObjectMap&>(event.getMap());
+            eventMap->emplace("target", mTarget->getEventTargetProperties());
+        }
     }
 
     // Evaluate all of the properties, including componentId (we store it for the debugger)
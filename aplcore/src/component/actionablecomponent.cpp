@@ -38,14 +38,20 @@ ActionableComponent::propDefSet() const {
 void
 ActionableComponent::executeOnBlur() {
     auto command = getCalculated(kPropertyOnBlur);
-    auto eventContext = createDefaultEventContext("Blur");
+    if (command.empty())
+        return;
+
+    auto eventContext = createHandlerContext(kPropertyOnBlur, "Blur", getValue());
     mContext->sequencer().executeCommands(command, eventContext, shared_from_this(), true);
 }
 
 void
 ActionableComponent::executeOnFocus() {
     auto command = getCalculated(kPropertyOnFocus);
-    auto eventContext = createDefaultEventContext("Focus");
+    if (command.empty())
+        return;
+
+    auto eventContext = createHandlerContext(kPropertyOnFocus, "Focus", getValue());
     mContext->sequencer().executeCommands(command, eventContext, shared_from_this(), true);
 }
 
@@ -53,38 +59,31 @@ ActionableComponent::executeOnFocus() {
 bool
 ActionableComponent::executeKeyHandlers(KeyHandlerType type, const ObjectMapPtr& keyboard) {
 
-    auto propertyKey = KeyboardManager::getHandlerPropertyKey(type);
-    auto handlerId = KeyboardManager::getHandlerId(type);
+    // The handler properties are not dynamic, so they only need to be parsed once
+    auto it = mKeyHandlers.find(type);
+    if (it == mKeyHandlers.end()) {
+        auto handlers = getCalculated(KeyboardManager::getHandlerPropertyKey(type));
+        it = mKeyHandlers.emplace(type, handlers.isArray() ?
+                                        KeyboardManager::compileKeyHandlers(*mContext, handlers.getArray()) :
+                                        KeyHandlerList()).first;
+    }
 
     // return false if no handlers ( not consumed )
-    auto handlers = getCalculated(propertyKey);
-    if (!handlers.isArray())
+    const auto& handlers = it->second;
+    if (handlers.empty())
         return false;
 
+    ContextPtr eventContext = createKeyboardEventContext(KeyboardManager::getHandlerId(type), keyboard);
+    auto handler = KeyboardManager::findKeyHandler(handlers, *eventContext, *keyboard);
+    if (!handler)
+        return false;
 
-    ContextPtr eventContext = createKeyboardEventContext(handlerId, keyboard);
-    bool consumed = false;
-
-    for (const auto& handler: handlers.getArray()) {
-
-        if (!handler.isMap()) {
-            continue;
-        }
-
-        auto when = propertyAsBoolean(*eventContext, handler, "when", false);
-        if (!when)
-            continue;
-
-        auto commands = Object(arrayifyProperty(getContext(), handler, "commands"));
-        if (!commands.empty()) {
-            mContext->sequencer().executeCommands(commands, eventContext, shared_from_this(), false);
-        }
-        consumed = !propertyAsBoolean(getContext(), handler, "propagate", false);
-        break;
-
+    auto commands = Object(arrayifyProperty(getContext(), handler->handler, "commands"));
+    if (!commands.empty()) {
+        mContext->sequencer().executeCommands(commands, eventContext, shared_from_this(), false);
     }
 
-    return consumed;
+    return !evaluate(*mContext, handler->propagate).asBoolean();
 }
 
 } // namespace apl
\ No newline at end of file
@@ -14,6 +14,7 @@
  */
 
 #include "apl/component/component.h"
+#include "apl/engine/context.h"
 #include "apl/utils/log.h"
 
 namespace apl {
@@ -23,9 +24,11 @@ id_type Component::sUniqueIdGenerator = 1000;
 
 Component::Component(const ContextPtr& context, const std::string& id)
     : mContext(context),
-      mUniqueId(':'+std::to_string(Component::sUniqueIdGenerator++)),
+      mUniqueId(Component::sUniqueIdGenerator++),
       mId(id),
-      mIsValid(true)
+      mIsValid(true),
+      mGlobalBoundsGeneration(0),
+      mGlobalBoundsValid(false)
 {
 }
 
@@ -52,6 +55,11 @@ Component::updateGraphic(const GraphicContentPtr& json) {
 bool
 Component::getBoundsInParent(const ComponentPtr& ancestor, Rect& out) const
 {
+    if (!ancestor) {
+        out = getGlobalBounds();
+        return true;
+    }
+
     out = mCalculated.get(kPropertyBounds).getRect();
 
     ComponentPtr parent = getParent();
@@ -62,10 +70,28 @@ Component::getBoundsInParent(const ComponentPtr& ancestor, Rect& out) const
     return parent == ancestor;
 }
 
+Rect
+Component::getGlobalBounds() const
+{
+    auto generation = mContext->layoutGeneration();
+    if (mGlobalBoundsValid && mGlobalBoundsGeneration == generation)
+        return mGlobalBounds;
+
+    // Each ancestor caches its own global bounds, so a full tree walk only visits each parent once
+    mGlobalBounds = mCalculated.get(kPropertyBounds).getRect();
+    ComponentPtr parent = getParent();
+    if (parent)
+        mGlobalBounds.offset(parent->getGlobalBounds().getTopLeft() - parent->scrollPosition());
+
+    mGlobalBoundsGeneration = generation;
+    mGlobalBoundsValid = true;
+    return mGlobalBounds;
+}
+
 std::string
 Component::toDebugString() const
 {
-    std::string result ="Component<" + name() + mUniqueId;
+    std::string result ="Component<" + name() + getUniqueId();
     if (!mId.empty())
         result += "(" + mId + ")";
 
@@ -82,7 +108,7 @@ Component::toDebugString() const
 std::string
 Component::toDebugSimpleString() const
 {
-    std::string result ="Component<" + name() + mUniqueId;
+    std::string result ="Component<" + name() + getUniqueId();
     if (!mId.empty())
         result += "(" + mId + ")";
     result += ">";
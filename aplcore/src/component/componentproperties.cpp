@@ -270,7 +270,8 @@ Bimap<int, std::string> sComponentPropertyBimap = {
         {kPropertyUser,                    "_user"},
         {kPropertyWidth,                   "width"},
         {kPropertyOnCursorEnter,           "onCursorEnter"},
-        {kPropertyOnCursorExit,            "onCursorExit"}
+        {kPropertyOnCursorExit,            "onCursorExit"},
+        {kPropertyGraphicChanges,          "graphicChanges"}
 };
 
 Bimap<int, std::string> sComponentTypeBimap = {
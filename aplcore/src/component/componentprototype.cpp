@@ -0,0 +1,67 @@
+/**
+ * Copyright 2019 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+#include <cstring>
+
+#include "apl/component/componentprototype.h"
+
+namespace apl {
+
+ComponentPrototype::ComponentPrototype(const rapidjson::Value& json)
+{
+    assert(json.IsObject());
+
+    for (const auto& m : json.GetObject()) {
+        mNames.push_back(m.name.GetString());
+
+        int key = sComponentPropertyBimap.get(m.name.GetString(), -1);
+        if (key == -1)
+            continue;
+
+        bool bound = m.value.IsString() &&
+                     (std::strstr(m.value.GetString(), "${") != nullptr || m.value.GetString()[0] == '@');
+        mEntries.emplace_back(Entry{static_cast<PropertyKey>(key), Object(m.value), bound});
+    }
+
+    // Property names are unique within a JSON object, so the keys are too
+    std::sort(mEntries.begin(), mEntries.end(),
+              [](const Entry& a, const Entry& b) { return a.key < b.key; });
+}
+
+bool
+ComponentPrototype::matches(const rapidjson::Value& json) const
+{
+    if (!json.IsObject() || json.MemberCount() != mNames.size())
+        return false;
+
+    auto it = mNames.begin();
+    for (const auto& m : json.GetObject())
+        if (m.name.GetString() != *it++)
+            return false;
+
+    return true;
+}
+
+const ComponentPrototype&
+ComponentPrototypes::get(const rapidjson::Value& json)
+{
+    auto& prototype = mPrototypes[&json];
+    if (!prototype || !prototype->matches(json))
+        prototype.reset(new ComponentPrototype(json));
+    return *prototype;
+}
+
+} // namespace apl
@@ -68,30 +68,15 @@ ContainerComponent::layoutPropDefSet() const
     return &sContainerChildProperties;
 }
 
-std::map<int,int>
-ContainerComponent::calculateChildrenVisualLayer(const std::map<int, float>& visibleIndexes,
-                                                 const Rect& visibleRect, int visualLayer) {
-    std::map<int,int> result;
-
-    if(visibleIndexes.empty()) {
-        return result;
-    }
-
-    std::vector<int> indexes;
-    indexes.reserve(visibleIndexes.size());
-    for(auto const& vi : visibleIndexes) {
-        indexes.emplace_back(vi.first);
-        result.emplace(vi.first, visualLayer);
-    }
-
-    for(int i=0; i<indexes.size(); i++) {
-        auto& childi = mChildren.at(indexes.at(i));
-        for(int j=i+1; j<visibleIndexes.size(); j++) {
-            auto childj = mChildren.at(indexes.at(j));
-            bool intersects = childi->calculateVisibleRect(visibleRect)
-                    .intersect(childj->calculateVisibleRect(visibleRect)).area() > 0;
-            if(intersects) {
-                result.at(indexes.at(j)) = result.at(indexes.at(i)) + 1;
+std::vector<int>
+ContainerComponent::calculateChildrenVisualLayer(const std::vector<std::pair<int, float>>& visibleIndexes,
+                                                 const std::vector<Rect>& visibleRects, int visualLayer) {
+    std::vector<int> result(visibleIndexes.size(), visualLayer);
+
+    for(size_t i=0; i<visibleRects.size(); i++) {
+        for(size_t j=i+1; j<visibleRects.size(); j++) {
+            if(visibleRects.at(i).intersect(visibleRects.at(j)).area() > 0) {
+                result.at(j) = result.at(i) + 1;
             }
         }
     }
@@ -99,15 +84,15 @@ ContainerComponent::calculateChildrenVisualLayer(const std::map<int, float>& vis
     return result;
 }
 
-std::map<int, float>
+std::vector<std::pair<int, float>>
 ContainerComponent::getChildrenVisibility(float realOpacity, const Rect &visibleRect) {
-    std::map<int, float> visibleIndexes;
+    std::vector<std::pair<int, float>> visibleIndexes;
 
     for(int index = 0; index < mChildren.size(); index++) {
         const auto& child = getCoreChildAt(index);
         float visibility = child->calculateVisibility(realOpacity, visibleRect);
         if(visibility > 0.0) {
-            visibleIndexes.emplace(index, visibility);
+            visibleIndexes.emplace_back(index, visibility);
         }
     }
 
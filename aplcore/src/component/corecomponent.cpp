@@ -13,10 +13,14 @@
  * permissions and limitations under the License.
  */
 
+#include <algorithm>
+#include <limits>
+
 #include <yoga/YGNode.h>
 
 #include "apl/component/corecomponent.h"
 #include "apl/component/componentpropdef.h"
+#include "apl/component/componentprototype.h"
 #include "apl/component/yogaproperties.h"
 #include "apl/engine/focusmanager.h"
 #include "apl/engine/hovermanager.h"
@@ -24,6 +28,8 @@
 #include "apl/engine/builder.h"
 #include "apl/engine/componentdependant.h"
 #include "apl/content/rootconfig.h"
+#include "apl/command/commandproperties.h"
+#include "apl/engine/evaluate.h"
 #include "apl/time/sequencer.h"
 #include "apl/primitives/keyboard.h"
 #include "apl/utils/session.h"
@@ -65,7 +71,8 @@ void CoreComponent::initialize()
     if (mInheritParentState && mParent)
         mState = mParent->getState();
 
-    // Assign the built-in properties.
+    // Assign the built-in properties.  Values equal to the shared defaults are not stored.
+    mCalculated.setDefaults(propDefSet().defaults());
     assignProperties(propDefSet());
 
     // Mixed states always match their properties
@@ -86,6 +93,7 @@ CoreComponent::release()
 {
     // TODO: Must remove this component from any dirty lists
     mParent = nullptr;
+    mContext->layoutChanged();
     for (auto& child : mChildren)
         child->release();
     mChildren.clear();
@@ -111,11 +119,30 @@ CoreComponent::findComponentById(const std::string& id) const
     if (id.empty())
         return nullptr;
 
-    if (mId == id || mUniqueId == id)
+    // Unique ids have the form ":N".  Parse N once so the search compares integers.
+    id_type uniqueId = 0;
+    if (id[0] == ':' && id.size() > 1 && id[1] != '0' &&
+        id.size() <= std::numeric_limits<id_type>::digits10 + 1) {
+        for (auto it = id.begin() + 1 ; it != id.end() ; it++) {
+            if (*it < '0' || *it > '9') {
+                uniqueId = 0;
+                break;
+            }
+            uniqueId = uniqueId * 10 + (*it - '0');
+        }
+    }
+
+    return findComponentById(id, uniqueId);
+}
+
+ComponentPtr
+CoreComponent::findComponentById(const std::string& id, id_type uniqueId) const
+{
+    if (mId == id || (uniqueId != 0 && mUniqueId == uniqueId))
         return std::const_pointer_cast<CoreComponent>(shared_from_this());
 
     for (auto& m : mChildren) {
-        auto result = m->findComponentById(id);
+        auto result = m->findComponentById(id, uniqueId);
         if (result)
             return result;
     }
@@ -161,6 +188,7 @@ CoreComponent::attachedToParent(const CoreComponentPtr& parent)
 {
     assert(parent != nullptr);
     mParent = parent;
+    mContext->layoutChanged();
 
     // Can only be called after the yoga nodes are arranged.
     auto layoutPropDefSet = getLayoutPropDefSet();
@@ -239,6 +267,7 @@ CoreComponent::insertChild(const ComponentPtr& child, size_t index, bool useDirt
     }
 
     coreChild->attachedToParent(shared_from_this());
+    childrenChanged();
     return true;
 }
 
@@ -263,6 +292,7 @@ CoreComponent::remove()
 
     mParent->removeChild(shared_from_this(), true);
     mParent = nullptr;
+    mContext->layoutChanged();
     return true;
 }
 
@@ -277,6 +307,7 @@ CoreComponent::removeChild(const CoreComponentPtr& child, bool useDirtyFlag)
 
     YGNodeRemoveChild(mYGNodeRef, child->getNode());
     mChildren.erase(it);
+    childrenChanged();
 
     // The parent component has changed the number of children
     if (useDirtyFlag)
@@ -379,6 +410,93 @@ CoreComponent::updateNodeProperties()
     }
 };
 
+namespace {
+
+/**
+ * The component properties of a component or style resolved to property keys and sorted by key.
+ * Property definition sets are also ordered by key, so a definition set can be matched against the
+ * list with a single forward walk instead of a string lookup per definition.
+ */
+class ResolvedProperties {
+public:
+    struct Entry {
+        PropertyKey key;
+        const Object *value;
+        bool bound;     // A string that may need data-binding
+    };
+
+    ResolvedProperties(const ResolvedProperties&) = delete;
+    ResolvedProperties& operator=(const ResolvedProperties&) = delete;
+
+    /**
+     * Resolve the assigned properties of a component.  Properties copied from JSON templates
+     * come from the compiled prototypes of those templates, so their names are only resolved
+     * once per document.  Anything else is resolved by name.
+     */
+    ResolvedProperties(Context& context, const Properties& properties) {
+        auto sources = properties.sources();
+        if (sources) {
+            for (const auto& json : *sources)
+                merge(context.getComponentPrototype(*json).entries());
+        }
+        else {
+            for (const auto& m : properties) {
+                int key = sComponentPropertyBimap.get(m.first, -1);
+                if (key != -1)
+                    mValues.emplace_back(Entry{static_cast<PropertyKey>(key), &m.second, m.second.isString()});
+            }
+
+            std::sort(mValues.begin(), mValues.end(),
+                      [](const Entry& a, const Entry& b) { return a.key < b.key; });
+        }
+
+        mNext = mValues.begin();
+    }
+
+    /**
+     * Use the properties of a style, which the style definition has already resolved.
+     */
+    explicit ResolvedProperties(const StyleInstance& style) {
+        for (const auto& m : style.componentProperties())
+            mValues.emplace_back(Entry{static_cast<PropertyKey>(m.first), m.second, false});
+        mNext = mValues.begin();
+    }
+
+    /**
+     * Find the entry for a key.  Keys must be requested in increasing order.
+     * @param key The property key.
+     * @return The entry or nullptr if the key was not assigned.
+     */
+    const Entry* find(PropertyKey key) {
+        while (mNext != mValues.end() && mNext->key < key)
+            mNext++;
+        return mNext != mValues.end() && mNext->key == key ? &*mNext : nullptr;
+    }
+
+private:
+    // Add the entries of a template.  A key assigned by an earlier template is kept.
+    void merge(const std::vector<ComponentPrototype::Entry>& entries) {
+        std::vector<Entry> merged;
+        merged.reserve(mValues.size() + entries.size());
+
+        auto it = mValues.begin();
+        for (const auto& e : entries) {
+            while (it != mValues.end() && it->key < e.key)
+                merged.push_back(*it++);
+            if (it != mValues.end() && it->key == e.key)
+                continue;
+            merged.emplace_back(Entry{e.key, &e.value, e.bound});
+        }
+        merged.insert(merged.end(), it, mValues.end());
+        mValues.swap(merged);
+    }
+
+    std::vector<Entry> mValues;
+    std::vector<Entry>::const_iterator mNext;
+};
+
+} // namespace
+
 /**
  * Initial assignment of properties.  Don't set any dirty flags here; this
  * all should be running in the constructor.
@@ -389,32 +507,49 @@ CoreComponent::assignProperties(const ComponentPropDefSet& propDefSet)
 {
     auto stylePtr = getStyle();
 
+    ResolvedProperties assigned(*mContext, mProperties);
+    std::unique_ptr<ResolvedProperties> styled(stylePtr ? new ResolvedProperties(*stylePtr) : nullptr);
+
+    // Properties left at their default value are already visible through the shared defaults
+    bool sharedDefaults = propDefSet.defaults() && propDefSet.defaults() == mCalculated.defaults();
+
     for (const auto& cpd : propDefSet) {
         const auto& pd = cpd.second;
         auto value = pd.defaultFunc ? pd.defaultFunc(*this, mContext->getRootConfig()) : pd.defvalue;
+        bool isDefault = !pd.defaultFunc;
 
         if ((pd.flags & kPropIn) != 0) {
             // Check for user-defined property
-            auto p = mProperties.find(pd.name);
-            if (p != mProperties.end()) {
-                // If the user assigned a string, we need to check for data binding
-                if (p->second.isString()) {
-                    auto tmp = parseDataBinding(*mContext, p->second.getString());  // Expand data-binding
+            auto entry = assigned.find(pd.key);
+            if (entry) {
+                const auto p = entry->value;
+                isDefault = false;
+
+                // A string may need data binding.  A constant string is used as it is.
+                if (p->isString() && !entry->bound) {
+                    value = pd.calculate(*mContext, *p);
+                    mAssigned[pd.key] = *p;
+                }
+                else if (p->isString()) {
+                    auto tmp = parseDataBinding(*mContext, p->getString());  // Expand data-binding
+                    auto result = evaluate(*mContext, tmp);
                     if (tmp.isNode()) {
                         std::set<std::string> symbols;
                         tmp.symbols(symbols);
                         auto self = std::static_pointer_cast<CoreComponent>(shared_from_this());
+                        auto memo = std::make_shared<ExpressionMemo>(symbols);
+                        memo->seed(*mContext, result);
                         for (const auto& symbol : symbols) {
                             auto c = mContext->findContextContaining(symbol);
                             if (c != nullptr)
-                                ComponentDependant::create(c, symbol, self, pd.key);
+                                ComponentDependant::create(c, symbol, self, pd.key, memo);
                         }
                     }
-                    value = pd.calculate(*mContext, evaluate(*mContext, tmp));  // Calculate the final value
+                    value = pd.calculate(*mContext, result);  // Calculate the final value
                     mAssigned[pd.key] = tmp;
                 }
                 else {
-                    value = pd.calculate(*mContext, p->second);
+                    value = pd.calculate(*mContext, *p);
                     mAssigned[pd.key] = value;
                 }
             } else {
@@ -425,21 +560,32 @@ CoreComponent::assignProperties(const ComponentPropDefSet& propDefSet)
                 }
 
                 // Check for a styled property
-                if ((pd.flags & kPropStyled) != 0 && stylePtr) {
-                    auto s = stylePtr->find(pd.name);
-                    if (s != stylePtr->end())
-                        value = pd.calculate(*mContext, s->second);
+                if ((pd.flags & kPropStyled) != 0 && styled) {
+                    auto s = styled->find(pd.key);
+                    if (s) {
+                        value = pd.calculate(*mContext, *s->value);
+                        isDefault = false;
+                    }
                 }
             }
         }
 
-        mCalculated.set(pd.key, value);
+        if (isDefault && sharedDefaults)
+            mCalculated.erase(pd.key);
+        else
+            mCalculated.set(pd.key, value);
 
         //Apply this property to the yn if we care about it
         if (pd.layoutFunc != nullptr)
             pd.layoutFunc(mYGNodeRef, value, *mContext);
     }
 
+    // Remember the style these properties were calculated from.  If the property sets were
+    // assigned from different styles, force the next style update to check everything.
+    if (!mAppliedStyle)
+        mAppliedStyle = stylePtr;
+    else if (mAppliedStyle != stylePtr)
+        mAppliedStyle = nullptr;
 }
 
 void
@@ -615,62 +761,116 @@ CoreComponent::markProperty(PropertyKey key)
 bool
 CoreComponent::recalculatePropertyInternal(const ComponentPropDefSet& propDefSet,
                                            PropertyKey key,
-                                           const Object& node)
+                                           const Object& value)
 {
     auto it = propDefSet.dynamic().find(key);
     if (it == propDefSet.dynamic().end())
         return false;
 
     const ComponentPropDef& def = it->second;
-    handlePropertyChange(def, def.calculate(*mContext, evaluate(*mContext, node)));
+    handlePropertyChange(def, def.calculate(*mContext, value));
     return true;
 }
 
 void
-CoreComponent::recalculateProperty(PropertyKey key)
+CoreComponent::recalculateProperty(PropertyKey key, ExpressionMemo& memo)
 {
     auto it = mAssigned.find(key);
-    if (it != mAssigned.end() && it->second.isNode()) {
+    if (it != mAssigned.end() && it->second.isNode() && memo.update(*mContext, it->second)) {
         // The property could be a standard component property or a layout property
-        if (!recalculatePropertyInternal(propDefSet(), key, it->second)) {
+        if (!recalculatePropertyInternal(propDefSet(), key, memo.value())) {
             auto layoutPDS = getLayoutPropDefSet();
             if (layoutPDS)
-                recalculatePropertyInternal(*layoutPDS, key, it->second);
+                recalculatePropertyInternal(*layoutPDS, key, memo.value());
         }
     }
 }
 
 /**
- * The style of the component may (or may not) have changed.  If it has changed,
- * update each styled property in turn.  Then update any children that share their
- * parent state.
+ * Recalculate a single styled property.
+ * @param pds The property definition set the property belongs to.
+ * @param key The property key.
+ * @param styleValue The value defined by the new style or nullptr if the style doesn't define it.
+ */
+void
+CoreComponent::updateStyledProperty(const ComponentPropDefSet& pds, PropertyKey key, const Object *styleValue)
+{
+    auto it = pds.styled().find(key);
+    if (it == pds.styled().end())
+        return;
+
+    const ComponentPropDef& pd = it->second;
+
+    // If the property was explicitly assigned by the user, the style won't change it.
+    if (mAssigned.count(pd.key))
+        return;
+
+    if (styleValue)
+        handlePropertyChange(pd, pd.calculate(*mContext, *styleValue));
+    else
+        handlePropertyChange(pd, pd.defaultFunc ? pd.defaultFunc(*this, mContext->getRootConfig()) : pd.defvalue);
+}
+
+/**
+ * The style of the component has changed from oldStyle to newStyle.  Update the styled
+ * properties that differ between the two.  If there is no old style, every styled property
+ * is checked.
  *
  * Calling this method sets dirty flags.
  */
 void
-CoreComponent::updateStyleInternal(const StyleInstancePtr& stylePtr, const ComponentPropDefSet& pds) {
+CoreComponent::updateStyleInternal(const StyleInstancePtr& oldStyle,
+                                   const StyleInstancePtr& newStyle,
+                                   const ComponentPropDefSet& pds) {
 
-    // Check every property that has the "styled" flag.
-    for (const auto& it : pds.styled()) {
-        const ComponentPropDef& pd = it.second;
+    if (!oldStyle) {
+        // Check every property that has the "styled" flag.
+        for (const auto& it : pds.styled()) {
+            const ComponentPropDef& pd = it.second;
 
-        // If the property was explicitly assigned by the user, the style won't change it.
-        if (mAssigned.count(pd.key))
-            continue;
+            // If the property was explicitly assigned by the user, the style won't change it.
+            if (mAssigned.count(pd.key))
+                continue;
 
-        // Check to see if the value has changed.
-        auto value = (pd.defaultFunc ? pd.defaultFunc(*this, mContext->getRootConfig()) : pd.defvalue);
-        auto s = stylePtr->find(pd.name);
-        if (s != stylePtr->end())
-            value = pd.calculate(*mContext, s->second);
+            // Check to see if the value has changed.
+            auto value = (pd.defaultFunc ? pd.defaultFunc(*this, mContext->getRootConfig()) : pd.defvalue);
+            auto s = newStyle->find(pd.name);
+            if (s != newStyle->end())
+                value = pd.calculate(*mContext, s->second);
 
-        handlePropertyChange(pd, value);
+            handlePropertyChange(pd, value);
+        }
+        return;
+    }
+
+    // Both component property lists are sorted by key.  A property can only change if it was
+    // added, removed, or assigned a different value.
+    const auto& oldProps = oldStyle->componentProperties();
+    const auto& newProps = newStyle->componentProperties();
+    auto oldIt = oldProps.begin();
+    auto newIt = newProps.begin();
+
+    while (oldIt != oldProps.end() || newIt != newProps.end()) {
+        if (newIt == newProps.end() || (oldIt != oldProps.end() && oldIt->first < newIt->first)) {
+            updateStyledProperty(pds, static_cast<PropertyKey>(oldIt->first), nullptr);
+            ++oldIt;
+        }
+        else if (oldIt == oldProps.end() || newIt->first < oldIt->first) {
+            updateStyledProperty(pds, static_cast<PropertyKey>(newIt->first), newIt->second);
+            ++newIt;
+        }
+        else {
+            if (*oldIt->second != *newIt->second)
+                updateStyledProperty(pds, static_cast<PropertyKey>(newIt->first), newIt->second);
+            ++oldIt;
+            ++newIt;
+        }
     }
 }
 
 /**
  * The style of the component may (or may not) have changed.  If it has changed,
- * update each styled property in turn.  Then update any children that share their
+ * update the styled properties that differ.  Then update any children that share their
  * parent state.
  *
  * Calling this method sets dirty flags.
@@ -681,11 +881,12 @@ void
 CoreComponent::updateStyle()
 {
     auto stylePtr = getStyle();
-    if (stylePtr) {
-        updateStyleInternal(stylePtr, propDefSet());
+    if (stylePtr && stylePtr != mAppliedStyle) {
+        updateStyleInternal(mAppliedStyle, stylePtr, propDefSet());
         const ComponentPropDefSet *layoutPDS = getLayoutPropDefSet();
         if (layoutPDS)
-            updateStyleInternal(stylePtr, *layoutPDS);
+            updateStyleInternal(mAppliedStyle, stylePtr, *layoutPDS);
+        mAppliedStyle = stylePtr;
     }
     for (auto child : mChildren) {
         if (child->mInheritParentState)
@@ -709,6 +910,7 @@ CoreComponent::setState( StateProperty stateProperty, bool value )
     }
 
     if (mState.set(stateProperty, value)) {
+        mContext->visualContextChanged();
         if (stateProperty == kStateDisabled) {
             if (value) {
                 mState.set(kStatePressed, false);
@@ -734,6 +936,7 @@ CoreComponent::setDirty( PropertyKey key )
 {
     if (mDirty.emplace(key).second)
         mContext->setDirty(shared_from_this());
+    mContext->visualContextChanged();
 }
 
 void
@@ -825,6 +1028,7 @@ CoreComponent::processLayoutChanges(bool useDirtyFlag)
 
     if (changed) {
         mCalculated.set(kPropertyBounds, std::move(rect));
+        mContext->layoutChanged();
         if (useDirtyFlag)
             setDirty(kPropertyBounds);
     }
@@ -898,6 +1102,57 @@ CoreComponent::createKeyboardEventContext(const std::string& handler, const Obje
     return ctx;
 }
 
+/**
+ * Check if a list of commands may read the "event" property.  Data-binding strings are parsed
+ * and their symbols checked for "event".  SendEvent reads event.source itself, and the bodies of
+ * macros and data-bound command types aren't known here, so those count as reading it too.
+ */
+static bool
+commandsUseEvent(const Context& context, const Object& object)
+{
+    if (object.isString()) {
+        auto parsed = parseDataBinding(context, object.getString());
+        if (!parsed.isNode())
+            return false;
+
+        std::set<std::string> symbols;
+        parsed.symbols(symbols);
+        return symbols.count("event") != 0;
+    }
+
+    if (object.isArray()) {
+        for (int i = 0 ; i < object.size() ; i++)
+            if (commandsUseEvent(context, object.at(i)))
+                return true;
+        return false;
+    }
+
+    if (object.isMap()) {
+        auto type = object.get("type");
+        if (type.isString()) {
+            auto commandType = sCommandNameBimap.get(type.getString(), -1);
+            if (commandType == -1 || commandType == kCommandTypeSendEvent)
+                return true;
+        }
+
+        for (const auto& m : object.getMap())
+            if (commandsUseEvent(context, m.second))
+                return true;
+    }
+
+    return false;
+}
+
+ContextPtr
+CoreComponent::createHandlerContext(PropertyKey key, const std::string& handler, const Object& value)
+{
+    auto it = mHandlerUsesEvent.find(key);
+    if (it == mHandlerUsesEvent.end())
+        it = mHandlerUsesEvent.emplace(key, commandsUseEvent(*mContext, getCalculated(key))).first;
+
+    return it->second ? createEventContext(handler, value) : mContext;
+}
+
 std::shared_ptr<ObjectMap>
 CoreComponent::getEventTargetProperties() const
 {
@@ -952,16 +1207,11 @@ CoreComponent::fixTransform(bool useDirtyFlag)
     }
 }
 
-std::map<int,int>
-CoreComponent::calculateChildrenVisualLayer(const std::map<int, float>& visibleIndexes,
-                                            const Rect& visibleRect, int visualLayer) {
-    std::map<int,int> result;
+std::vector<int>
+CoreComponent::calculateChildrenVisualLayer(const std::vector<std::pair<int, float>>& visibleIndexes,
+                                            const std::vector<Rect>& visibleRects, int visualLayer) {
     // For general case child has it's parent's layer.
-    for(const auto &vi : visibleIndexes) {
-        result.emplace(vi.first, visualLayer);
-    }
-
-    return result;
+    return std::vector<int>(visibleIndexes.size(), visualLayer);
 }
 
 rapidjson::Value
@@ -969,7 +1219,7 @@ CoreComponent::serialize(rapidjson::Document::AllocatorType& allocator) const
 {
     rapidjson::Value component(rapidjson::kObjectType);
 
-    component.AddMember("id", rapidjson::Value(mUniqueId.c_str(), allocator).Move(), allocator);
+    component.AddMember("id", rapidjson::Value(getUniqueId().c_str(), allocator).Move(), allocator);
     component.AddMember("type", getType(), allocator);
 
     for (const auto& pds : propDefSet()) {
@@ -995,7 +1245,7 @@ CoreComponent::serializeAll(rapidjson::Document::AllocatorType& allocator) const
 {
     rapidjson::Value component(rapidjson::kObjectType);
 
-    component.AddMember("id", rapidjson::Value(mUniqueId.c_str(), allocator).Move(), allocator);
+    component.AddMember("id", rapidjson::Value(getUniqueId().c_str(), allocator).Move(), allocator);
     component.AddMember("type", rapidjson::StringRef(sComponentTypeBimap.at(getType()).c_str()), allocator);
 
     component.AddMember("__id", rapidjson::Value(mId.c_str(), allocator), allocator);
@@ -1031,7 +1281,7 @@ rapidjson::Value
 CoreComponent::serializeDirty(rapidjson::Document::AllocatorType& allocator) {
     rapidjson::Value component(rapidjson::kObjectType);
 
-    component.AddMember("id", rapidjson::Value(mUniqueId.c_str(), allocator).Move(), allocator);
+    component.AddMember("id", rapidjson::Value(getUniqueId().c_str(), allocator).Move(), allocator);
     for (auto& key : mDirty) {
         component.AddMember(
             rapidjson::Value(sComponentPropertyBimap.at(key).c_str(), allocator),
@@ -1078,13 +1328,19 @@ CoreComponent::serializeVisualContextInternal(rapidjson::Value &outArray, rapidj
     // Process children
     if (!mChildren.empty() && visibility > 0.0) {
         auto visibleIndexes = getChildrenVisibility(realOpacity, visibleRect);
-        auto visualLayers = calculateChildrenVisualLayer(visibleIndexes, visibleRect, visualLayer);
-        for (auto childIdx : visibleIndexes) {
+        std::vector<Rect> visibleRects;
+        visibleRects.reserve(visibleIndexes.size());
+        for (const auto& childIdx : visibleIndexes)
+            visibleRects.emplace_back(mChildren.at(childIdx.first)->calculateVisibleRect(visibleRect));
+
+        auto visualLayers = calculateChildrenVisualLayer(visibleIndexes, visibleRects, visualLayer);
+        for (size_t i = 0 ; i < visibleIndexes.size() ; i++) {
+            const auto& childIdx = visibleIndexes.at(i);
             const auto& child = mChildren.at(childIdx.first);
-            auto childVisibleRect = child->calculateVisibleRect(visibleRect);
+            const auto& childVisibleRect = visibleRects.at(i);
             auto childRealOpacity = child->calculateRealOpacity(realOpacity);
             auto childVisibility = childIdx.second;
-            auto childVisualLayer = visualLayers.at(childIdx.first);
+            auto childVisualLayer = visualLayers.at(i);
             child->serializeVisualContextInternal(
                     includeInContext? children : outArray, allocator,
                     childRealOpacity, childVisibility, childVisibleRect, childVisualLayer);
@@ -1120,7 +1376,7 @@ CoreComponent::serializeVisualContextInternal(rapidjson::Value &outArray, rapidj
     if(!mId.empty()) {
         visualContext.AddMember("id", rapidjson::Value(mId.c_str(), allocator).Move(), allocator);
     }
-    visualContext.AddMember("uid", rapidjson::Value(mUniqueId.c_str(), allocator).Move(), allocator);
+    visualContext.AddMember("uid", rapidjson::Value(getUniqueId().c_str(), allocator).Move(), allocator);
     visualContext.AddMember("position", rapidjson::Value((getGlobalBounds().toString() + ":"
                             + std::to_string(visualLayer)).c_str(), allocator).Move(), allocator);
     visualContext.AddMember("type", rapidjson::Value(getVisualContextType().c_str(), allocator), allocator);
@@ -1149,16 +1405,16 @@ CoreComponent::getVisualContextType() {
     return !type.empty() ? type : VISUAL_CONTEXT_TYPE_EMPTY;
 }
 
-std::map<int, float>
+std::vector<std::pair<int, float>>
 CoreComponent::getChildrenVisibility(float realOpacity, const Rect &visibleRect) {
     // Multi children components have specific implementation. Just return single one if it's there.
     assert(mChildren.size() <= 1);
-    std::map<int, float> result;
+    std::vector<std::pair<int, float>> result;
     if(!mChildren.empty()) {
         auto child = mChildren.at(0);
         auto childVisibility = child->calculateVisibility(realOpacity, visibleRect);
         if(childVisibility > 0.0) {
-            result.emplace(0, childVisibility);
+            result.emplace_back(0, childVisibility);
         }
     }
 
@@ -1257,15 +1513,21 @@ CoreComponent::calculateRealOpacity() {
 
 void
 CoreComponent::executeOnCursorEnter() {
-    auto eventContext = createDefaultEventContext("CursorEnter");
     auto command = getCalculated(kPropertyOnCursorEnter);
+    if (command.empty())
+        return;
+
+    auto eventContext = createHandlerContext(kPropertyOnCursorEnter, "CursorEnter", getValue());
     mContext->sequencer().executeCommands(command, eventContext, shared_from_this(), true);
 }
 
 void
 CoreComponent::executeOnCursorExit() {
-    auto eventContext = createDefaultEventContext("CursorExit");
     auto command = getCalculated(kPropertyOnCursorExit);
+    if (command.empty())
+        return;
+
+    auto eventContext = createHandlerContext(kPropertyOnCursorExit, "CursorExit", getValue());
     mContext->sequencer().executeCommands(command, eventContext, shared_from_this(), true);
 }
 
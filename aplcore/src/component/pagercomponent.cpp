@@ -75,12 +75,16 @@ PagerComponent::update(UpdateType type, float value) {
     if (type == kUpdatePagerPosition || type == kUpdatePagerByEvent) {
         if (value != mCurrentPage) {
             mCurrentPage = value;
-            ContextPtr eventContext = createEventContext("Page", mCurrentPage);
-            mContext->sequencer().executeCommands(
-                    getCalculated(kPropertyOnPageChanged),
-                    eventContext,
-                    shared_from_this(),
-                    type == kUpdatePagerByEvent);  // If the user set the pager, run in fast mode.
+            mContext->visualContextChanged();
+            auto commands = getCalculated(kPropertyOnPageChanged);
+            if (!commands.empty()) {
+                ContextPtr eventContext = createHandlerContext(kPropertyOnPageChanged, "Page", mCurrentPage);
+                mContext->sequencer().executeCommands(
+                        commands,
+                        eventContext,
+                        shared_from_this(),
+                        type == kUpdatePagerByEvent);  // If the user set the pager, run in fast mode.
+            }
         }
 
     } else
@@ -140,15 +144,15 @@ PagerComponent::pageDirection() const {
     }
 }
 
-std::map<int, float>
+std::vector<std::pair<int, float>>
 PagerComponent::getChildrenVisibility(float realOpacity, const Rect& visibleRect) {
-    std::map<int, float> result;
+    std::vector<std::pair<int, float>> result;
 
     if (!mChildren.empty()) {
         auto child = mChildren.at(mCurrentPage);
         auto childVisibility = child->calculateVisibility(realOpacity, visibleRect);
         if (childVisibility > 0.0) {
-            result.emplace(mCurrentPage, childVisibility);
+            result.emplace_back(mCurrentPage, childVisibility);
         }
     }
 
@@ -26,12 +26,15 @@ ScrollableComponent::update(UpdateType type, float value)
     if (type == kUpdateScrollPosition) {
         if (value != mCurrentPosition) {
             mCurrentPosition = value;
-            ContextPtr eventContext = createEventContext("Scroll", getValue());
-            mContext->sequencer().executeCommands(
-                getCalculated(kPropertyOnScroll),
-                eventContext,
-                shared_from_this(),
-                true);
+            mContext->visualContextChanged();
+            mContext->layoutChanged();
+
+            // onScroll fires every scroll frame; only build the event properties if they are read
+            auto commands = getCalculated(kPropertyOnScroll);
+            if (!commands.empty()) {
+                ContextPtr eventContext = createHandlerContext(kPropertyOnScroll, "Scroll", getValue());
+                mContext->sequencer().executeCommands(commands, eventContext, shared_from_this(), true);
+            }
         }
     }
     else
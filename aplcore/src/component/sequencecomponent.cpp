@@ -13,6 +13,9 @@
  * permissions and limitations under the License.
  */
 
+#include <cmath>
+#include <limits>
+
 #include "apl/component/componentpropdef.h"
 #include "apl/component/sequencecomponent.h"
 #include "apl/component/yogaproperties.h"
@@ -20,6 +23,10 @@
 
 namespace apl {
 
+// A batch of children ensured in one layout pass covers at most the viewport plus this fraction
+// of the viewport, so a poor extent estimate can't lay out a long run of children we don't need.
+static const float ENSURE_MARGIN = 0.5f;
+
 CoreComponentPtr
 SequenceComponent::create(const ContextPtr& context,
                           Properties&& properties,
@@ -35,7 +42,8 @@ SequenceComponent::SequenceComponent(const ContextPtr& context,
                                      const std::string& path)
     : ScrollableComponent(context, std::move(properties), path),
       mHighestIndexSeen(-1),
-      mFirstUnensuredChild(0)
+      mFirstUnensuredChild(0),
+      mChildExtentsValid(false)
 {
 }
 
@@ -48,16 +56,57 @@ SequenceComponent::update(UpdateType type, float value)
     }
 }
 
+void
+SequenceComponent::processLayoutChanges(bool useDirtyFlag)
+{
+    ScrollableComponent::processLayoutChanges(useDirtyFlag);
+    updateChildExtents();
+}
+
+void
+SequenceComponent::updateChildExtents()
+{
+    bool vertical = scrollType() == kScrollTypeVertical;
+    size_t count = std::min(static_cast<size_t>(mFirstUnensuredChild), mChildren.size());
+
+    mExtentEndMax.resize(count);
+    mExtentStartMin.resize(count);
+
+    float endMax = -std::numeric_limits<float>::infinity();
+    for (size_t i = 0 ; i < count ; i++) {
+        auto bounds = mChildren[i]->getCalculated(kPropertyBounds).getRect();
+        endMax = std::max(endMax, vertical ? bounds.getBottom() : bounds.getRight());
+        mExtentEndMax[i] = endMax;
+        mExtentStartMin[i] = vertical ? bounds.getTop() : bounds.getLeft();
+    }
+
+    for (size_t i = count ; i-- > 1 ; )
+        mExtentStartMin[i - 1] = std::min(mExtentStartMin[i - 1], mExtentStartMin[i]);
+
+    mChildExtentsValid = true;
+}
+
 ComponentPtr
 SequenceComponent::findChildAtPosition(const Point& position) const
 {
-    // Not all children may be ensured.  We start at the end of the list of ensured children
-    // TODO: Given the serial nature of layout in a Sequence, a binary search would be faster
-
+    // Not all children may be ensured.  We only search the ensured children.
     if (mChildren.empty())
         return nullptr;
 
-    for (int i = mFirstUnensuredChild - 1 ; i >= 0 ; i-- ) {
+    int first = 0;
+    int last = std::min(mFirstUnensuredChild, static_cast<int>(mChildren.size())) - 1;
+
+    // Narrow the search to the children whose extent along the scroll axis can contain the
+    // position.  If the index is out of date (children changed without a layout pass) we
+    // check every ensured child.
+    if (mChildExtentsValid && mExtentEndMax.size() == static_cast<size_t>(last + 1)) {
+        float offset = scrollType() == kScrollTypeVertical ? position.getY() : position.getX();
+        first = std::lower_bound(mExtentEndMax.begin(), mExtentEndMax.end(), offset) - mExtentEndMax.begin();
+        last = std::upper_bound(mExtentStartMin.begin(), mExtentStartMin.end(), offset) - mExtentStartMin.begin() - 1;
+    }
+
+    // Later children are drawn on top of earlier children, so search backwards
+    for (int i = last ; i >= first ; i--) {
         auto child = mChildren.at(i)->findComponentAtPosition(position);
         if (child != nullptr)
             return child;
@@ -121,48 +170,54 @@ SequenceComponent::scrollPosition() const
 Point
 SequenceComponent::trimScroll(const Point& point) const
 {
-    auto innerBounds = mCalculated.get(kPropertyInnerBounds).getRect();
+    bool vertical = scrollType() == kScrollTypeVertical;
+    float target = vertical ? point.getY() : point.getX();
+    if (target <= 0)
+        return Point();
 
-    if (scrollType() == kScrollTypeVertical) {
-        auto y = point.getY();
-        if (y <= 0)
-            return Point();
-
-        float bottom = innerBounds.getBottom();
-        float maxY = 0;
-
-        // Ensure children until they cover the sequence.
-        int startingChild = std::max(mFirstUnensuredChild - 1, 0);
-        for (int i = startingChild ; i<mChildren.size() ; i++) {
-            const auto& child = mChildren.at(i);
-            child->ensureLayout(false);
-            maxY = nonNegative(child->getCalculated(kPropertyBounds).getRect().getBottom() - bottom);
-            if (y <= maxY)
-                return Point(0,y);
+    auto innerBounds = mCalculated.get(kPropertyInnerBounds).getRect();
+    float limit = vertical ? innerBounds.getBottom() : innerBounds.getRight();
+    float window = (1 + ENSURE_MARGIN) * (vertical ? innerBounds.getHeight() : innerBounds.getWidth());
+
+    auto nearEdge = [&](int index) {
+        auto bounds = mChildren.at(index)->getCalculated(kPropertyBounds).getRect();
+        return vertical ? bounds.getTop() : bounds.getLeft();
+    };
+    auto farEdge = [&](int index) {
+        auto bounds = mChildren.at(index)->getCalculated(kPropertyBounds).getRect();
+        return vertical ? bounds.getBottom() : bounds.getRight();
+    };
+    auto result = [&](float value) {
+        return vertical ? Point(0, value) : Point(value, 0);
+    };
+
+    float maxOffset = 0;
+    int count = mChildren.size();
+
+    // Ensure children until they cover the sequence.  When we run past the ensured children we
+    // estimate how many more are needed from the average extent of the children laid out so
+    // far and ensure them in a single layout pass, rather than one layout pass per child.  Each
+    // pass is capped at the viewport plus a margin; a long jump takes several passes, each with
+    // a better estimate than the last.
+    for (int i = std::max(mFirstUnensuredChild - 1, 0) ; i < count ; i++) {
+        if (i >= mFirstUnensuredChild) {
+            int last = i;
+            if (i > 0) {
+                float average = (farEdge(i - 1) - nearEdge(0)) / i;
+                float needed = std::min(target + limit - farEdge(i - 1), window);
+                if (average > 0)
+                    last = i + static_cast<int>(std::ceil(needed / average)) - 1;
+                last = std::max(i, std::min(last, count - 1));
+            }
+            mChildren.at(last)->ensureLayout(false);
         }
 
-        return Point(0, maxY);
+        maxOffset = nonNegative(farEdge(i) - limit);
+        if (target <= maxOffset)
+            return result(target);
     }
-    else {  // Horizontal
-        auto x = point.getX();
-        if (x <= 0)
-            return Point();
-
-        float right = innerBounds.getRight();
-        float maxX = 0;
-
-        // Ensure children until they cover the sequence.
-        int startingChild = std::max(mFirstUnensuredChild - 1, 0);
-        for (int i = startingChild ; i<mChildren.size(); i++) {
-            const auto& child = mChildren.at(i);
-            child->ensureLayout(false);
-            maxX = nonNegative(child->getCalculated(kPropertyBounds).getRect().getRight() - right);
-            if (x <= maxX)
-                return Point(x,0);
-        }
 
-        return Point(maxX, 0);
-    }
+    return result(maxOffset);
 }
 
 const ComponentPropDefSet*
@@ -233,9 +288,9 @@ SequenceComponent::allowForward() const {
 }
 
 
-std::map<int, float>
+std::vector<std::pair<int, float>>
 SequenceComponent::getChildrenVisibility(float realOpacity, const Rect &visibleRect) {
-    std::map<int, float> visibleIndexes;
+    std::vector<std::pair<int, float>> visibleIndexes;
     bool visibleMet = false;
 
     for (int index = 0; index < mFirstUnensuredChild; index++) {
@@ -243,7 +298,7 @@ SequenceComponent::getChildrenVisibility(float realOpacity, const Rect &visibleR
         float childVisibility = child->calculateVisibility(realOpacity, visibleRect);
         if(childVisibility > 0.0) {
             visibleMet = true;
-            visibleIndexes.emplace(index, childVisibility);
+            visibleIndexes.emplace_back(index, childVisibility);
         }
         else if(visibleMet) {
             // Check if we have element outside of sequence viewport. If so - break out the loop.
@@ -259,7 +314,7 @@ SequenceComponent::updateSeen() {
     // We don't always go from parent to child here (update case) so calculate opacity and visible rect recursively.
     auto visibleIndexes = getChildrenVisibility(calculateRealOpacity(), calculateVisibleRect());
     if(!visibleIndexes.empty()) {
-        mHighestIndexSeen = std::max(visibleIndexes.rbegin()->first, mHighestIndexSeen);
+        mHighestIndexSeen = std::max(visibleIndexes.back().first, mHighestIndexSeen);
     }
 }
 
@@ -216,7 +216,7 @@ TextComponent::serializeMeasure(rapidjson::Document::AllocatorType& allocator) c
 {
     rapidjson::Value component(rapidjson::kObjectType);
 
-    component.AddMember("id", rapidjson::Value(mUniqueId.c_str(), allocator).Move(), allocator);
+    component.AddMember("id", rapidjson::Value(getUniqueId().c_str(), allocator).Move(), allocator);
 
     for (const auto& pds : propDefSet()) {
         if ((pds.second.flags & kPropLayout) != 0)
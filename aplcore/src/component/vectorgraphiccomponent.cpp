@@ -16,6 +16,7 @@
 #include "apl/component/componentpropdef.h"
 #include "apl/component/vectorgraphiccomponent.h"
 #include "apl/component/yogaproperties.h"
+#include "apl/content/rootconfig.h"
 #include "apl/graphic/graphic.h"
 
 namespace apl {
@@ -105,7 +106,7 @@ VectorGraphicComponent::updateStyle()
     auto graphic = mCalculated.get(kPropertyGraphic);
     auto stylePtr = getStyle();
     if (stylePtr && graphic.isGraphic() && graphic.getGraphic()->updateStyle(stylePtr))
-        setDirty(kPropertyGraphic);
+        setGraphicDirty();
 
     // Changing the style may result in a size change or a position change
     processLayoutChanges(true);
@@ -239,7 +240,7 @@ VectorGraphicComponent::processLayoutChanges(bool useDirtyFlag)
 
         // The graphic may need to be resized based on the new layout
         if (g->layout(width, height, useDirtyFlag) && useDirtyFlag)
-            setDirty(kPropertyGraphic);
+            setGraphicDirty();
     }
 }
 
@@ -249,6 +250,36 @@ VectorGraphicComponent::getVisualContextType()
     return getCalculated(kPropertyGraphic).isNull() ? VISUAL_CONTEXT_TYPE_EMPTY : VISUAL_CONTEXT_TYPE_GRAPHIC;
 }
 
+void
+VectorGraphicComponent::setGraphicDirty()
+{
+    setDirty(mContext->getRootConfig().getIncrementalGraphicUpdates() ? kPropertyGraphicChanges : kPropertyGraphic);
+}
+
+/**
+ * Changes to the elements of the current graphic are serialized as an array of the changed
+ * elements and their changed properties, and the element dirty flags are then cleared.  If the
+ * full graphic is serialized as well, it already carries those changes.
+ */
+rapidjson::Value
+VectorGraphicComponent::serializeDirty(rapidjson::Document::AllocatorType& allocator)
+{
+    bool changes = mDirty.erase(kPropertyGraphicChanges) > 0;
+    bool replaced = mDirty.count(kPropertyGraphic) > 0;
+    auto component = CoreComponent::serializeDirty(allocator);
+
+    auto graphic = mCalculated.get(kPropertyGraphic);
+    if (changes && graphic.isGraphic()) {
+        auto g = graphic.getGraphic();
+        if (!replaced)
+            component.AddMember(rapidjson::StringRef(sComponentPropertyBimap.at(kPropertyGraphicChanges).c_str()),
+                                g->serializeDirty(allocator), allocator);
+        g->clearDirty();
+    }
+
+    return component;
+}
+
 bool
 VectorGraphicComponent::setPropertyInternal(const std::string& key, const apl::Object& value)
 {
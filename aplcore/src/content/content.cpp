@@ -20,6 +20,7 @@
 #include "apl/content/package.h"
 #include "apl/engine/propdef.h"
 #include "apl/content/importrequest.h"
+#include "apl/content/packagecache.h"
 #include "apl/content/content.h"
 #include "apl/content/jsondata.h"
 #include "apl/content/metrics.h"
@@ -42,6 +43,12 @@ Content::create(JsonData&& document)
 
 ContentPtr
 Content::create(JsonData&& document, const SessionPtr& session)
+{
+    return create(std::move(document), session, nullptr);
+}
+
+ContentPtr
+Content::create(JsonData&& document, const SessionPtr& session, const PackageCachePtr& cache)
 {
     if (!document) {
         CONSOLE_S(session).log("Document parse error offset=%u: %s", document.offset(), document.error());
@@ -64,14 +71,16 @@ Content::create(JsonData&& document, const SessionPtr& session)
     for (const auto& v : params)
         parameterNames.push_back(v.name);
 
-    return std::make_shared<Content>(session, ptr, it->value, std::move(parameterNames));
+    return std::make_shared<Content>(session, ptr, it->value, std::move(parameterNames), cache);
 }
 
 Content::Content(const SessionPtr &session,
                  const PackagePtr& mainPackagePtr,
                  const rapidjson::Value& mainTemplate,
-                 std::vector<std::string>&& parameterNames)
+                 std::vector<std::string>&& parameterNames,
+                 const PackageCachePtr& cache)
     : mSession(session),
+      mCache(cache),
       mMainPackage(mainPackagePtr),
       mMainParameters(std::move(parameterNames)),
       mState(LOADING),
@@ -144,8 +153,17 @@ Content::addPackage(const ImportRequest& request, JsonData&& raw)
             it++;
     }
 
-    // Insert into the mLoaded list.  Note that json has been moved
-    auto ptr = Package::create(mSession, request.reference().toString(), std::move(raw));
+    // Insert into the mLoaded list.  Note that json has been moved.  Cached packages can
+    // outlive both this Content and the caller's JSON, so a package that references memory
+    // it does not own is deep-copied into a document of its own before it is cached.
+    PackagePtr ptr;
+    if (mCache && !raw.ownsData()) {
+        rapidjson::Document copy;
+        copy.CopyFrom(raw.get(), copy.GetAllocator());
+        ptr = Package::create(mSession, request.reference().toString(), JsonData(std::move(copy)));
+    }
+    else
+        ptr = Package::create(mSession, request.reference().toString(), std::move(raw));
     if (!ptr) {
         LOGF(LogLevel::ERROR, "Package %s (%s) could not be moved to the loaded list.",
                 request.reference().name().c_str(),
@@ -154,12 +172,23 @@ Content::addPackage(const ImportRequest& request, JsonData&& raw)
         return;
     }
 
-    mLoaded.emplace(request.reference(), ptr);
-    // Process the import list for this package
-    addImportList(*ptr);
+    addLoaded(request.reference(), ptr);
+
+    // The import list has been processed, so the package won't be modified again
+    if (mCache)
+        mCache->add(request.reference(), ptr);
+
     updateStatus();
 }
 
+void
+Content::addLoaded(const ImportRef& ref, const PackagePtr& package)
+{
+    mLoaded.emplace(ref, package);
+    // Process the import list for this package
+    addImportList(*package);
+}
+
 void Content::addData(const std::string& name, JsonData&& raw) {
     if (mState != LOADING)
         return;
@@ -209,7 +238,7 @@ Content::getMainProperties(Properties& out) const
 }
 
 void
-Content::addImportList(Package& package)
+Content::addImportList(const Package& package)
 {
     LOG_IF(DEBUG_CONTENT) << "addImportList " << &package;
 
@@ -228,7 +257,7 @@ Content::addImportList(Package& package)
 }
 
 void
-Content::addImport(Package& package, const rapidjson::Value& value)
+Content::addImport(const Package& package, const rapidjson::Value& value)
 {
     LOG_IF(DEBUG_CONTENT) << "addImport " << &package;
 
@@ -245,13 +274,18 @@ Content::addImport(Package& package, const rapidjson::Value& value)
         return;
     }
 
-    package.addDependency(request.reference());
-
     if (mRequested.find(request) == mRequested.end() &&
         mPending.find(request) == mPending.end() &&
         mLoaded.find(request.reference()) == mLoaded.end()) {
-        // It is a new request
-        mRequested.insert(std::move(request));
+        // It is a new request.  Resolve it from the cache if possible; cached packages
+        // pull in their own (possibly cached) imports without a round trip to the caller.
+        auto cached = mCache ? mCache->find(request.reference()) : nullptr;
+        if (cached) {
+            LOG_IF(DEBUG_CONTENT) << "cached package " << request.reference().toString();
+            addLoaded(request.reference(), cached);
+        }
+        else
+            mRequested.insert(std::move(request));
     }
 }
 
@@ -13,11 +13,14 @@
  * permissions and limitations under the License.
  */
 
+#include "apl/content/importrequest.h"
 #include "apl/content/package.h"
 #include "apl/utils/session.h"
 
 namespace apl {
 
+extern const char *DOCUMENT_IMPORT;
+
 const char *DOCUMENT_TYPE = "type";
 const char *DOCUMENT_VERSION = "version";
 
@@ -51,6 +54,77 @@ Package::create(const SessionPtr& session, const std::string& name, JsonData&& j
     return std::make_shared<Package>(name, std::move(json));
 }
 
+static void
+addDefinitions(std::map<std::string, JsonResource>& out, const rapidjson::Value& json, const char *section,
+               const Path& base)
+{
+    auto it = json.FindMember(section);
+    if (it == json.MemberEnd() || !it->value.IsObject())
+        return;
+
+    const auto path = base.addObject(section);
+    for (const auto& kv : it->value.GetObject()) {
+        const auto& name = kv.name.GetString();
+        out[name] = { &kv.value, path.addObject(name) };
+    }
+}
+
+/**
+ * Estimate the memory held by a JSON value that wasn't parsed from text: the values themselves
+ * plus the characters of every string and member name.
+ */
+static size_t
+estimateSize(const rapidjson::Value& value)
+{
+    size_t size = sizeof(rapidjson::Value);
+    if (value.IsString())
+        size += value.GetStringLength();
+    else if (value.IsArray()) {
+        for (const auto& m : value.GetArray())
+            size += estimateSize(m);
+    }
+    else if (value.IsObject()) {
+        for (const auto& m : value.GetObject())
+            size += estimateSize(m.name) + estimateSize(m.value);
+    }
+    return size;
+}
+
+Package::Package(const std::string& name, JsonData&& json)
+    : mJson(std::move(json)),
+      mName(name),
+      mSize(mJson.bytesParsed() ? mJson.bytesParsed() : estimateSize(mJson.get()))
+{
+    const auto& value = mJson.get();
+
+    auto it = value.FindMember(DOCUMENT_IMPORT);
+    if (it != value.MemberEnd() && it->value.IsArray()) {
+        for (const auto& v : it->value.GetArray()) {
+            if (!v.IsObject())
+                continue;
+            ImportRequest request(v);
+            if (request.isValid() &&
+                std::find(mDependencies.begin(), mDependencies.end(), request.reference()) == mDependencies.end())
+                mDependencies.push_back(request.reference());
+        }
+    }
+}
+
+// A cached package may be used from several threads, so each variant is built exactly once
+const Package::Definitions&
+Package::definitions(bool trackProvenance) const
+{
+    auto& definitions = mDefinitions[trackProvenance];
+    std::call_once(definitions.built, [&]() {
+        const auto& value = mJson.get();
+        const auto base = Path(trackProvenance ? mName : std::string());
+        addDefinitions(definitions.layouts, value, "layouts", base);
+        addDefinitions(definitions.commands, value, "commands", base);
+        addDefinitions(definitions.graphics, value, "graphics", base);
+    });
+    return definitions;
+}
+
 const std::string
 Package::version()
 {
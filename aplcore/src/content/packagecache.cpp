@@ -0,0 +1,129 @@
+/**
+ * Copyright 2019 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include "apl/content/packagecache.h"
+#include "apl/content/package.h"
+
+namespace apl {
+
+PackagePtr
+PackageCache::find(const ImportRef& ref)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    auto it = mIndex.find(ref);
+    if (it == mIndex.end()) {
+        mMisses++;
+        return nullptr;
+    }
+
+    mHits++;
+    mEntries.splice(mEntries.begin(), mEntries, it->second);
+    return it->second->second;
+}
+
+void
+PackageCache::add(const ImportRef& ref, const PackagePtr& package)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    if (mCapacity == 0)
+        return;
+
+    auto it = mIndex.find(ref);
+    if (it != mIndex.end()) {
+        mMemoryUse -= it->second->second->size();
+        it->second->second = package;
+        mEntries.splice(mEntries.begin(), mEntries, it->second);
+    }
+    else {
+        mEntries.emplace_front(ref, package);
+        mIndex.emplace(ref, mEntries.begin());
+    }
+
+    mMemoryUse += package->size();
+    while (overLimit())
+        evictOne();
+}
+
+bool
+PackageCache::overLimit() const
+{
+    // Never evict the package that was just added
+    if (mEntries.size() <= 1)
+        return false;
+
+    return mEntries.size() > mCapacity || (mMemoryBudget > 0 && mMemoryUse > mMemoryBudget);
+}
+
+void
+PackageCache::evictOne()
+{
+    // Prefer the least-recently-used package that isn't held by a Content object.
+    auto victim = std::prev(mEntries.end());
+    for (auto it = mEntries.rbegin() ; it != mEntries.rend() ; it++) {
+        if (it->second.use_count() == 1) {
+            victim = std::prev(it.base());
+            break;
+        }
+    }
+
+    // The most recently added package stays
+    if (victim == mEntries.begin())
+        victim = std::prev(mEntries.end());
+
+    mMemoryUse -= victim->second->size();
+    mIndex.erase(victim->first);
+    mEntries.erase(victim);
+}
+
+void
+PackageCache::clear()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    mIndex.clear();
+    mEntries.clear();
+    mMemoryUse = 0;
+}
+
+size_t
+PackageCache::size() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mEntries.size();
+}
+
+size_t
+PackageCache::memoryUse() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mMemoryUse;
+}
+
+size_t
+PackageCache::hits() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mHits;
+}
+
+size_t
+PackageCache::misses() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mMisses;
+}
+
+} // namespace apl
@@ -27,6 +27,8 @@ RootConfig::RootConfig()
       mLocalTime(0),
       mLocalTimeAdjustment(0),
       mAnimationQuality(kAnimationQualityNormal),
+      mOffloadAnimations(false),
+      mIncrementalGraphicUpdates(false),
       mAllowOpenUrl(false),
       mDisallowVideo(false),
       mDefaultIdleTimeout(30000),
@@ -37,6 +39,7 @@ RootConfig::RootConfig()
       mDefaultThemeFontColor({{"light", 0x1E2222FF}, {"dark", 0xfafafaff}}),
       mDefaultFontFamily("sans-serif"),
       mTrackProvenance(true),
+      mCompileExpressions(false),
       mDefaultComponentSize({
           // Set default sizes for components that aren't "auto" width and "auto" height.
         {{kComponentTypeImage, true}, {Dimension(100), Dimension(100)}},
@@ -0,0 +1,326 @@
+/**
+ * Copyright 2019 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <cassert>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+#include "apl/datagrammar/bytecode.h"
+#include "apl/engine/context.h"
+
+namespace apl {
+namespace datagrammar {
+
+// Most expressions never need more than a handful of stack slots
+static const size_t INLINE_STACK_SIZE = 8;
+
+// The operator of the ByteCode node itself.  It evaluates the original tree.
+static Object
+EvalTree(const Context& context, const std::vector<Object>& args)
+{
+    return args.at(0).eval(context);
+}
+
+class ByteCodeCompiler {
+public:
+    explicit ByteCodeCompiler(ByteCode& byteCode) : mByteCode(byteCode) {}
+
+    void compile(const Object& object)
+    {
+        if (!object.isNode()) {
+            emit(kByteCodeLoadConstant, constant(object));
+            push();
+            return;
+        }
+
+        const auto& node = object.getNode();
+        auto op = node.getOperator();
+        const auto& args = node.getArgs();
+
+        if (op == SymbolAccess) {
+            emit(kByteCodeLoadSymbol, constant(args.at(0)));
+            push();
+        }
+        else if (auto unary = unaryCalculation(op)) {
+            compile(args.at(0));
+            emit(kByteCodeUnary, 0).unary = unary;
+        }
+        else if (auto binary = binaryCalculation(op)) {
+            if (!args.at(1).isNode()) {
+                compile(args.at(0));
+                emit(kByteCodeBinaryConstant, constant(args.at(1))).binary = binary;
+            }
+            else if (!args.at(0).isNode()) {
+                compile(args.at(1));
+                emit(kByteCodeConstantBinary, constant(args.at(0))).binary = binary;
+            }
+            else {
+                compile(args.at(0));
+                compile(args.at(1));
+                emit(kByteCodeBinary, 0).binary = binary;
+                pop(1);
+            }
+        }
+        else if (op == EvalAnd)
+            shortCircuit(kByteCodeAndJump, args);
+        else if (op == EvalOr)
+            shortCircuit(kByteCodeOrJump, args);
+        else if (op == EvalNullc)
+            shortCircuit(kByteCodeNullcJump, args);
+        else if (op == EvalUnaryTernary) {
+            compile(args.at(0));
+            auto jumpToFalse = mByteCode.mInstructions.size();
+            emit(kByteCodePopJumpIfFalse, 0);
+            pop(1);
+            compile(args.at(1));
+            auto jumpToEnd = mByteCode.mInstructions.size();
+            emit(kByteCodeJump, 0);
+            pop(1);   // Only one of the two branches is on the stack at the end
+            mByteCode.mInstructions[jumpToFalse].value = mByteCode.mInstructions.size();
+            compile(args.at(2));
+            mByteCode.mInstructions[jumpToEnd].value = mByteCode.mInstructions.size();
+        }
+        else if (op == EvalCombine) {
+            // Only the nodes are evaluated onto the stack; the literal text is read from the node
+            size_t nodeCount = 0;
+            for (const auto& m : args) {
+                if (m.isNode()) {
+                    compile(m);
+                    nodeCount++;
+                }
+            }
+            emit(kByteCodeCombine, constant(object));
+            pop(nodeCount);
+            push();
+        }
+        else if (op == EvalFunctionCall) {
+            compile(args.at(0));
+            const auto& list = args.at(1);
+            for (size_t i = 0 ; i < list.size() ; i++)
+                compile(list.at(i));
+            emit(kByteCodeCall, list.size());
+            pop(list.size());
+        }
+        else {
+            emit(kByteCodeLoadNode, constant(object));
+            push();
+        }
+    }
+
+private:
+    void shortCircuit(ByteCodeOpcode opcode, const std::vector<Object>& args)
+    {
+        compile(args.at(0));
+        auto jump = mByteCode.mInstructions.size();
+        emit(opcode, 0);
+        pop(1);
+        compile(args.at(1));
+        mByteCode.mInstructions[jump].value = mByteCode.mInstructions.size();
+    }
+
+    ByteCodeInstruction& emit(ByteCodeOpcode opcode, int value)
+    {
+        ByteCodeInstruction instruction;
+        instruction.opcode = opcode;
+        instruction.value = value;
+        instruction.unary = nullptr;
+        mByteCode.mInstructions.push_back(instruction);
+        return mByteCode.mInstructions.back();
+    }
+
+    int constant(const Object& object)
+    {
+        mByteCode.mConstants.push_back(object);
+        return mByteCode.mConstants.size() - 1;
+    }
+
+    void push()
+    {
+        mDepth++;
+        if (mDepth > mByteCode.mMaxDepth)
+            mByteCode.mMaxDepth = mDepth;
+    }
+
+    void pop(size_t count) { mDepth -= count; }
+
+private:
+    ByteCode& mByteCode;
+    size_t mDepth = 0;
+};
+
+Object
+ByteCode::compile(const Object& object)
+{
+    if (!object.isNode())
+        return object;
+
+    return std::static_pointer_cast<Node>(std::make_shared<ByteCode>(object));
+}
+
+ByteCode::ByteCode(const Object& tree)
+    : Node(EvalTree, std::vector<Object>{tree}, "bytecode"),
+      mMaxDepth(0)
+{
+    ByteCodeCompiler(*this).compile(tree);
+    LOG_IF(DEBUG_NODE) << "Compiled " << tree << " into " << mInstructions.size()
+                       << " instructions, stack depth " << mMaxDepth;
+}
+
+/**
+ * The value stack used while running a program.  Slots live in inline storage for typical
+ * programs and are only constructed while they hold a value, so a short program doesn't pay to
+ * construct and destroy the whole stack.
+ */
+class ValueStack {
+public:
+    explicit ValueStack(size_t capacity)
+        : mData(reinterpret_cast<Object *>(mInline)),
+          mSize(0)
+    {
+        if (capacity > INLINE_STACK_SIZE) {
+            mHeap.reset(new Slot[capacity]);
+            mData = reinterpret_cast<Object *>(mHeap.get());
+        }
+    }
+
+    ~ValueStack() { pop(mSize); }
+
+    void push(const Object& object) { new (mData + mSize++) Object(object); }
+    void push(Object&& object) { new (mData + mSize++) Object(std::move(object)); }
+
+    void pop(size_t count = 1) {
+        for (size_t i = 0 ; i < count ; i++)
+            mData[--mSize].~Object();
+    }
+
+    // Access an item counting back from the top; at(1) is the top of the stack
+    Object& at(size_t fromTop) { return mData[mSize - fromTop]; }
+    Object& top() { return at(1); }
+
+    size_t size() const { return mSize; }
+
+private:
+    using Slot = std::aligned_storage<sizeof(Object), alignof(Object)>::type;
+
+    Slot mInline[INLINE_STACK_SIZE];
+    std::unique_ptr<Slot[]> mHeap;
+    Object *mData;
+    size_t mSize;
+};
+
+Object
+ByteCode::eval(const Context& context) const
+{
+    ValueStack stack(mMaxDepth);
+    const auto count = mInstructions.size();
+    size_t pc = 0;
+
+    while (pc < count) {
+        const auto& instruction = mInstructions[pc++];
+        switch (instruction.opcode) {
+            case kByteCodeLoadConstant:
+                stack.push(mConstants[instruction.value]);
+                break;
+            case kByteCodeLoadSymbol:
+                stack.push(context.opt(mConstants[instruction.value].getString()));
+                break;
+            case kByteCodeLoadNode:
+                stack.push(mConstants[instruction.value].eval(context));
+                break;
+            case kByteCodeUnary:
+                stack.top() = instruction.unary(stack.top());
+                break;
+            case kByteCodeBinary: {
+                auto result = instruction.binary(stack.at(2), stack.at(1));
+                stack.pop();
+                stack.top() = std::move(result);
+                break;
+            }
+            case kByteCodeBinaryConstant:
+                stack.top() = instruction.binary(stack.top(), mConstants[instruction.value]);
+                break;
+            case kByteCodeConstantBinary:
+                stack.top() = instruction.binary(mConstants[instruction.value], stack.top());
+                break;
+            case kByteCodeAndJump:
+                if (!stack.top().truthy())
+                    pc = instruction.value;
+                else
+                    stack.pop();
+                break;
+            case kByteCodeOrJump:
+                if (stack.top().asBoolean())
+                    pc = instruction.value;
+                else
+                    stack.pop();
+                break;
+            case kByteCodeNullcJump:
+                if (!stack.top().isNull())
+                    pc = instruction.value;
+                else
+                    stack.pop();
+                break;
+            case kByteCodePopJumpIfFalse: {
+                bool condition = stack.top().asBoolean();
+                stack.pop();
+                if (!condition)
+                    pc = instruction.value;
+                break;
+            }
+            case kByteCodeJump:
+                pc = instruction.value;
+                break;
+            case kByteCodeCombine: {
+                const auto& args = mConstants[instruction.value].getNode().getArgs();
+                size_t nodeCount = 0;
+                for (const auto& m : args)
+                    nodeCount += m.isNode();
+
+                std::string result;
+                auto value = &stack.at(nodeCount);
+                for (const auto& m : args) {
+                    const auto& item = m.isNode() ? *value++ : m;
+                    if (item.isString())
+                        result += item.getString();
+                    else
+                        result += item.asString();
+                }
+
+                stack.pop(nodeCount);
+                stack.push(Object(result));
+                break;
+            }
+            case kByteCodeCall: {
+                const auto& func = stack.at(instruction.value + 1);
+                auto first = &stack.at(instruction.value);
+                auto result = func.isFunction() ?
+                              func.call(std::vector<Object>(first, first + instruction.value)) :
+                              Object::NULL_OBJECT();
+                stack.pop(instruction.value + 1);
+                stack.push(std::move(result));
+                break;
+            }
+        }
+    }
+
+    assert(stack.size() == 1);
+    auto result = std::move(stack.top());
+    LOG_IF(DEBUG_NODE) << *this << " ---> " << result;
+    return result;
+}
+
+} // namespace datagrammar
+} // namespace apl
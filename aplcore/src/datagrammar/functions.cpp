@@ -15,7 +15,9 @@
 
 #include <cassert>
 #include <cmath>
+#include <map>
 
+#include "apl/datagrammar/functions.h"
 #include "apl/datagrammar/node.h"
 #include "apl/engine/context.h"
 #include "apl/primitives/dimension.h"
@@ -29,18 +31,18 @@ Object Unary(const Context& context, const std::vector<Object>& args) {
     return func(args.at(0).eval(context));
 }
 
+// Only evaluated arguments are copied; constant arguments are passed by reference
 template<Object (*func)(const Object&, const Object&)>
 Object Binary(const Context& context, const std::vector<Object>& args) {
-    auto a = args.at(0);
-    auto b = args.at(1);
-
-    if (a.isNode())
-        a = a.eval(context);
+    const auto& a = args.at(0);
+    const auto& b = args.at(1);
 
-    if (b.isNode())
-        b = b.eval(context);
+    if (a.isNode()) {
+        auto evalA = a.eval(context);
+        return b.isNode() ? func(evalA, b.eval(context)) : func(evalA, b);
+    }
 
-    return func(a, b);
+    return b.isNode() ? func(a, b.eval(context)) : func(a, b);
 }
 
 Object
@@ -555,14 +557,11 @@ NotEqual(std::vector<Object>&& args) {
     return CalculateNotEqual(args.at(0), args.at(1));
 }
 
+// Short-circuit: "b" is only evaluated when "a" is truthy
 Object
-CalculateAnd(const Object& a, const Object& b) {
-    return a.truthy() ? b : a;
-}
-
-Object
-CalculateUnaryTruthy(const Object& a) {
-    return a;
+EvalAnd(const Context& context, const std::vector<Object>& args) {
+    auto a = args[0].eval(context);
+    return a.truthy() ? args[1].eval(context) : a;
 }
 
 Object
@@ -571,25 +570,23 @@ And(std::vector<Object>&& args) {
 
     auto a = args.at(0);
 
-    // If "a" is a node, we always need to evaluate and calculate
+    // If "a" is a node, we always need to evaluate it
     if (a.isNode())
-        return std::make_shared<Node>(Binary<CalculateAnd>, std::move(args), "&&");
+        return std::make_shared<Node>(EvalAnd, std::move(args), "&&");
 
     // "a" is not a node and it is false.  Simply return "a' and ignore b
     if (!a.asBoolean())
         return a;
 
-    // "a" is not a node and it is true.  Check if "b" is a node
-    auto b = args.at(1);
-    if (b.isNode())
-        return std::make_shared<Node>(Unary<CalculateUnaryTruthy>, std::vector<Object>{b}, "&&");
-
-    return b;
+    // "a" is not a node and it is true.  The result is "b", whether or not it is a node
+    return args.at(1);
 }
 
+// Short-circuit: "b" is only evaluated when "a" is false
 Object
-CalculateOr(const Object& a, const Object& b) {
-    return a.asBoolean() ? a : b;
+EvalOr(const Context& context, const std::vector<Object>& args) {
+    auto a = args[0].eval(context);
+    return a.asBoolean() ? a : args[1].eval(context);
 }
 
 Object
@@ -600,23 +597,21 @@ Or(std::vector<Object>&& args) {
 
     // If "a" is a node, we always evaluate
     if (a.isNode())
-        return std::make_shared<Node>(Binary<CalculateOr>, std::move(args), "||");
+        return std::make_shared<Node>(EvalOr, std::move(args), "||");
 
     // "a" is not a node.  If it is true, simply return it
     if (a.asBoolean())
         return a;
 
-    // "a" is not a node and it is false.  The return value depends on b.
-    auto b = args[1];
-    if (b.isNode())
-        return std::make_shared<Node>(Unary<CalculateUnaryTruthy>, std::vector<Object>{b}, "||");
-
-    return b;
+    // "a" is not a node and it is false.  The result is "b", whether or not it is a node
+    return args[1];
 }
 
+// Short-circuit: "b" is only evaluated when "a" is null
 Object
-CalculateNullc(const Object& a, const Object& b) {
-    return a.isNull() ? b : a;
+EvalNullc(const Context& context, const std::vector<Object>& args) {
+    auto a = args[0].eval(context);
+    return a.isNull() ? args[1].eval(context) : a;
 }
 
 Object
@@ -626,30 +621,18 @@ Nullc(std::vector<Object>&& args) {
     auto a = args[0];
 
     if (a.isNode())
-        return std::make_shared<Node>(Binary<CalculateNullc>, std::move(args), "??");
+        return std::make_shared<Node>(EvalNullc, std::move(args), "??");
 
     if (!a.isNull())
         return a;
 
-    auto b = args[1];
-
-    if (b.isNode())
-        return std::make_shared<Node>(Unary<CalculateUnaryTruthy>, std::vector<Object>{b}, "??");
-
-    return b;
+    return args[1];
 }
 
 Object
 EvalUnaryTernary(const Context& context, const std::vector<Object>& args)
 {
-    auto a = args[0];
-    if (a.isNode())
-        a = a.eval(context);
-
-    auto b = args.at(a.asBoolean() ? 1 : 2);
-    if (b.isNode())
-        b = b.eval(context);
-    return b;
+    return args.at(args[0].eval(context).asBoolean() ? 1 : 2).eval(context);
 }
 
 Object
@@ -673,17 +656,48 @@ Object
 EvalCombine(const Context& context, const std::vector<Object>& args) {
     std::string result;
 
-    for (auto m : args) {
-        if (m.isNode())
-            m = m.eval(context);
-        if (m.isString() && m.getString().empty())
-            continue;
-        result += m.asString();
+    for (const auto& m : args) {
+        if (m.isNode()) {
+            auto value = m.eval(context);
+            if (!value.isString() || !value.getString().empty())
+                result += value.asString();
+        }
+        else if (m.isString())
+            result += m.getString();   // Empty strings were dropped when the node was built
+        else
+            result += m.asString();
     }
 
     return result;
 }
 
+/**
+ * Build the argument list for an EvalCombine node.  Empty strings are dropped, the arguments of
+ * nested combine nodes are spliced in, and runs of adjacent constants are concatenated into a
+ * single string, so evaluation only visits the nodes and the literal text between them.
+ */
+static void
+flattenCombine(const std::vector<Object>& args, std::vector<Object>& out, std::string& pending)
+{
+    for (const auto& m : args) {
+        if (m.isNode()) {
+            const auto& node = m.getNode();
+            if (node.getOperator() == EvalCombine) {
+                flattenCombine(node.getArgs(), out, pending);
+                continue;
+            }
+
+            if (!pending.empty()) {
+                out.emplace_back(pending);
+                pending.clear();
+            }
+            out.emplace_back(m);
+        }
+        else if (!m.isString() || !m.getString().empty())
+            pending += m.asString();
+    }
+}
+
 Object
 Combine(std::vector<Object>&& args) {
     assert(args.size() > 1);
@@ -708,17 +722,19 @@ Combine(std::vector<Object>&& args) {
     if (count == 0)
         return Object("");
 
-    // One argument is non-empty; that's our return value
-    if (count == 1) {
-        auto a = args.at(non_null_index);
-        if (a.isNode())
-            return std::make_shared<Node>(Unary<CalculateUnaryTruthy>, std::vector<Object>{a}, "combine");
-        return a;
-    }
+    // One argument is non-empty; that's our return value (evaluated later if it is a node)
+    if (count == 1)
+        return args.at(non_null_index);
 
     // There are at least two non-empty elements and one node.  Defer our calculation
-    if (node_count > 0)
-        return std::make_shared<Node>(EvalCombine, std::move(args), "combine");
+    if (node_count > 0) {
+        std::vector<Object> flattened;
+        std::string pending;
+        flattenCombine(args, flattened, pending);
+        if (!pending.empty())
+            flattened.emplace_back(pending);
+        return std::make_shared<Node>(EvalCombine, std::move(flattened), "combine");
+    }
 
     // There are at least two non-empty elements and no nodes.  Combine everything
     std::string result;
@@ -734,8 +750,7 @@ Combine(std::vector<Object>&& args) {
 // Keep this as a separate function so that Nodes can identify symbols by comparing function pointers
 Object
 SymbolAccess(const Context& context, const std::vector<Object>& args) {
-    auto key = args.at(0).asString();
-    return context.opt(key);
+    return context.opt(args.at(0).getString());
 }
 
 Object
@@ -759,7 +774,7 @@ Symbol(const Context& context, std::vector<Object>&& args, const std::string& na
 Object
 CalcFieldAccess(const Object& a, const Object& b) {
     if (a.isMap() && b.isString())
-        return a.get(b.asString());
+        return a.get(b.getString());
 
     if (a.isArray() && b.isString() && b.getString() == "length")
         return a.size();
@@ -782,7 +797,7 @@ FieldAccess(std::vector<Object>&& args)
 Object
 CalcArrayAccess(const Object& a, const Object& b) {
     if (a.isMap() && b.isString())
-        return a.get(b.asString());
+        return a.get(b.getString());
 
     if (a.isArray()) {
         if (b.isString() && b.getString() == "length")
@@ -828,6 +843,7 @@ EvalFunctionCall(const Context& context, const std::vector<Object>& args)
 
     auto len = b.size();
     std::vector<Object> argArray;
+    argArray.reserve(len);
 
     for (int i = 0; i < len; i++)
         argArray.emplace_back(b.at(i).eval(context));
@@ -864,5 +880,41 @@ FunctionCall(std::vector<Object>&& args)
     return a.call(argArray);
 }
 
+UnaryFunc
+unaryCalculation(OperatorFunc op)
+{
+    static const std::map<OperatorFunc, UnaryFunc> sUnary = {
+        {Unary<CalculateUnaryPlus>,  CalculateUnaryPlus},
+        {Unary<CalculateUnaryMinus>, CalculateUnaryMinus},
+        {Unary<CalculateUnaryNot>,   CalculateUnaryNot},
+    };
+
+    auto it = sUnary.find(op);
+    return it != sUnary.end() ? it->second : nullptr;
+}
+
+BinaryFunc
+binaryCalculation(OperatorFunc op)
+{
+    static const std::map<OperatorFunc, BinaryFunc> sBinary = {
+        {Binary<CalculateMultiply>,     CalculateMultiply},
+        {Binary<CalculateDivide>,       CalculateDivide},
+        {Binary<CalculateRemainder>,    CalculateRemainder},
+        {Binary<CalculateAdd>,          CalculateAdd},
+        {Binary<CalculateSubtract>,     CalculateSubtract},
+        {Binary<CalculateLessThan>,     CalculateLessThan},
+        {Binary<CalculateGreaterThan>,  CalculateGreaterThan},
+        {Binary<CalculateLessEqual>,    CalculateLessEqual},
+        {Binary<CalculateGreaterEqual>, CalculateGreaterEqual},
+        {Binary<CalculateEqual>,        CalculateEqual},
+        {Binary<CalculateNotEqual>,     CalculateNotEqual},
+        {Binary<CalcFieldAccess>,       CalcFieldAccess},
+        {Binary<CalcArrayAccess>,       CalcArrayAccess},
+    };
+
+    auto it = sBinary.find(op);
+    return it != sBinary.end() ? it->second : nullptr;
+}
+
 }  // namespace datagrammar
 }  // namespace apl
@@ -233,10 +233,12 @@ Builder::expandSingleComponent(const ContextPtr& context,
             if (tmp.isNode()) {
                 std::set<std::string> symbols;
                 tmp.symbols(symbols);
+                auto memo = std::make_shared<ExpressionMemo>(symbols);
+                memo->seed(*expanded, value);
                 for (const auto& symbol : symbols) {
                     auto c = expanded->findContextContaining(symbol);
                     if (c != nullptr)
-                        ContextDependant::create(c, symbol, expanded, name, expanded, tmp, bindingFunc);
+                        ContextDependant::create(c, symbol, expanded, name, expanded, tmp, bindingFunc, memo);
                 }
             }
         }
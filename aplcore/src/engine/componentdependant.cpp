@@ -22,8 +22,9 @@ namespace apl {
 void ComponentDependant::create(const ContextPtr& upstreamContext,
                                 const std::string& upstreamName,
                                 const CoreComponentPtr& downstreamComponent,
-                                PropertyKey downstreamKey) {
-    auto dependant = std::make_shared<ComponentDependant>(upstreamContext, downstreamComponent, downstreamKey);
+                                PropertyKey downstreamKey,
+                                const std::shared_ptr<ExpressionMemo>& memo) {
+    auto dependant = std::make_shared<ComponentDependant>(upstreamContext, downstreamComponent, downstreamKey, memo);
     upstreamContext->addDownstream(upstreamName, dependant);
     downstreamComponent->addUpstream(downstreamKey, dependant);
 }
@@ -41,7 +42,7 @@ ComponentDependant::recalculate(bool useDirtyFlag) const
 {
     auto component = mDownstreamComponent.lock();
     if (component)
-        component->recalculateProperty(mDownstreamKey);
+        component->recalculateProperty(mDownstreamKey, *mMemo);
 }
 
 } // namespace apl
\ No newline at end of file
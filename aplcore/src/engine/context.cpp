@@ -141,6 +141,13 @@ Context::getStyle(const std::string& name, const State& state)
     return mCore->styles().get(shared_from_this(), name, state);
 }
 
+const ComponentPrototype&
+Context::getComponentPrototype(const rapidjson::Value& json)
+{
+    assert(mCore);
+    return mCore->componentPrototypes().get(json);
+}
+
 const JsonResource
 Context::getLayout(const std::string& name) const
 {
@@ -210,6 +217,30 @@ Context::setDirty(const ComponentPtr& ptr) {
     mCore->dirty.emplace(ptr);
 }
 
+void
+Context::visualContextChanged() {
+    assert(mCore);
+    mCore->visualContextChanged();
+}
+
+void
+Context::layoutChanged() {
+    assert(mCore);
+    mCore->layoutChanged();
+}
+
+unsigned int
+Context::layoutGeneration() const {
+    assert(mCore);
+    return mCore->layoutGeneration();
+}
+
+RecalculationStats&
+Context::recalculationStats() {
+    assert(mCore);
+    return mCore->recalculationStats();
+}
+
 void
 Context::clearDirty(const ComponentPtr& ptr)
 {
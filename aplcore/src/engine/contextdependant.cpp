@@ -27,18 +27,27 @@ ContextDependant::create(const ContextPtr& upstreamContext,
                          const std::string& downstreamName,
                          const ContextPtr& evaluationContext,
                          const Object& node,
-                         BindingFunction func)
+                         BindingFunction func,
+                         const std::shared_ptr<ExpressionMemo>& memo)
 {
     LOG_IF(DEBUG_CONTEXT_DEP)
             << "from: " << upstreamName << "(" << upstreamContext.get()
             << ") to: " << downstreamName << " (" << downstreamContext.get() << ")";
 
+    std::shared_ptr<ExpressionMemo> dependantMemo = memo;
+    if (!dependantMemo) {
+        std::set<std::string> symbols;
+        node.symbols(symbols);
+        dependantMemo = std::make_shared<ExpressionMemo>(symbols);
+    }
+
     auto dependant = std::make_shared<ContextDependant>(upstreamContext,
                                                         downstreamContext,
                                                         evaluationContext,
                                                         downstreamName,
                                                         node,
-                                                        func);
+                                                        func,
+                                                        dependantMemo);
     upstreamContext->addDownstream(upstreamName, dependant);
     downstreamContext->addUpstream(downstreamName, dependant);
 }
@@ -59,10 +68,8 @@ ContextDependant::recalculate(bool useDirtyFlag) const
 {
     auto downstream = mDownstreamContext.lock();
     auto evaluation = mEvaluationContext.lock();
-    if (downstream && evaluation) {
-        auto value = mEval(*evaluation, evaluate(*evaluation, mNode));
-        downstream->propagate(mName, value, useDirtyFlag);
-    }
+    if (downstream && evaluation && mMemo->update(*evaluation, mNode))
+        downstream->propagate(mName, mEval(*evaluation, mMemo->value()), useDirtyFlag);
 }
 
 } // namespace apl
@@ -13,7 +13,12 @@
  * permissions and limitations under the License.
  */
 
+#include <cstring>
+#include <memory>
+
 #include "apl/engine/evaluate.h"
+#include "apl/content/rootconfig.h"
+#include "apl/datagrammar/bytecode.h"
 #include "apl/datagrammar/databindingrules.h"
 #include "apl/engine/context.h"
 #include "apl/primitives/dimension.h"
@@ -24,6 +29,22 @@ namespace apl {
 
 const bool DEBUG_DATA_BINDING = false;
 
+/**
+ * A string without a "${" start sequence parses to itself, so there is no need to run
+ * the parser.
+ */
+static inline bool
+mayContainDataBinding(const char *value)
+{
+    return std::strstr(value, "${") != nullptr;
+}
+
+/**
+ * Parser state is kept per thread and reused, so a parse normally allocates nothing but the
+ * resulting nodes.  A nested parse on the same thread finds the slot empty and uses its own state.
+ */
+static thread_local std::unique_ptr<datagrammar::Stacks> sSpareStacks;
+
 /**
  * Evaluation stages we need:
  *
@@ -34,19 +55,31 @@ const bool DEBUG_DATA_BINDING = false;
 const Object
 parseDataBinding(const Context& context, const std::string& value)
 {
+    if (!mayContainDataBinding(value.c_str()))
+        return value;
+
+    std::unique_ptr<datagrammar::Stacks> stacks = std::move(sSpareStacks);
+    if (!stacks)
+        stacks.reset(new datagrammar::Stacks());
+
+    Object result = value;
     try {
-        pegtl::data_parser parser(value, "parseDataBinding");
-        datagrammar::Stacks stacks(context);
-        parser.parse<datagrammar::grammar, datagrammar::action>(stacks);
-        Object result = stacks.finish();
+        // Parse the string in place; data_parser would copy it
+        stacks->start(context);
+        pegtl::parse<datagrammar::grammar, datagrammar::action>(value.data(), value.data() + value.size(),
+                                                                "parseDataBinding", *stacks);
+        result = stacks->finish();
+        if (result.isNode() && context.getRootConfig().getCompileExpressions())
+            result = datagrammar::ByteCode::compile(result);
         LOG_IF(DEBUG_DATA_BINDING) << "Parse data binding " << value << "=" << result;
-        return result;
     }
-    catch (pegtl::parse_error e) {
+    catch (const pegtl::parse_error& e) {
         CONSOLE_CTX(context) << "Parse error in '" << value << "' - " << e.what();
     }
 
-    return value;
+    stacks->clear();
+    sSpareStacks = std::move(stacks);
+    return result;
 }
 
 const Object
@@ -65,9 +98,9 @@ evaluatePostDataBinding(const Context& context, const Object& object)
     auto result = object.isNode() ? object.eval(context) : object;
 
     // Strings get a resource check
-    if (result.isString()) {
-        std::string s = result.getString();
-        if (!s.empty() && s[0] == '@' && context.has(s))
+    if (result.isString() && result.getStringData()[0] == '@') {
+        const auto& s = result.getString();
+        if (context.has(s))
             return context.opt(s);    // This isn't efficient because we do a has() and a get().
     }
 
@@ -78,16 +111,17 @@ const Object
 evaluate(const Context& context, const Object& object)
 {
     // If it is a string, we check for data-binding
-    auto result = object.isString() ? parseDataBinding(context, object.getString()) : object;
+    auto result = object.isString() && mayContainDataBinding(object.getStringData()) ?
+                  parseDataBinding(context, object.getString()) : object;
 
     // Nodes get evaluated
     if (result.isNode())
         result = result.eval(context);
 
     // Strings get a resource check
-    if (result.isString()) {
-        std::string s = result.getString();
-        if (!s.empty() && s[0] == '@' && context.has(s))
+    if (result.isString() && result.getStringData()[0] == '@') {
+        const auto& s = result.getString();
+        if (context.has(s))
             return context.opt(s);    // This isn't efficient because we do a has() and a get().
     }
 
@@ -104,12 +138,13 @@ const Object
 evaluateRecursive(const Context& context, const Object& object)
 {
     if (object.isString()) {
-        auto result = applyDataBinding(context, object.getString());
+        auto result = mayContainDataBinding(object.getStringData()) ?
+                      applyDataBinding(context, object.getString()) : object;
 
         // Check for resources
-        if (result.isString()) {
-            std::string s = result.getString();
-            if (!s.empty() && s[0] == '@' && context.has(s))
+        if (result.isString() && result.getStringData()[0] == '@') {
+            const auto& s = result.getString();
+            if (context.has(s))
                 return context.opt(s);    // This isn't efficient because we do a has() and a get().
         }
 
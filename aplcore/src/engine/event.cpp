@@ -30,7 +30,8 @@ Bimap<int, std::string> sEventTypeBimap = {
     {kEventTypeScrollTo,     "scrollTo"},
     {kEventTypeSendEvent,    "sendEvent"},
     {kEventTypeSetPage,      "setPage"},
-    {kEventTypeSpeak,        "speak"}
+    {kEventTypeSpeak,        "speak"},
+    {kEventTypeAnimateItem,  "animateItem"}
 };
 
 Bimap<int, std::string> sEventPropertyBimap = {
@@ -44,7 +45,11 @@ Bimap<int, std::string> sEventPropertyBimap = {
     {kEventPropertyHighlightMode, "highlightMode"},
     {kEventPropertyPosition,      "position"},
     {kEventPropertySource,        "source"},
-    {kEventPropertyValue,         "value"}
+    {kEventPropertyValue,         "value"},
+    {kEventPropertyDuration,      "duration"},
+    {kEventPropertyEasing,        "easing"},
+    {kEventPropertyRepeatCount,   "repeatCount"},
+    {kEventPropertyRepeatMode,    "repeatMode"}
 };
 
 class EventData {
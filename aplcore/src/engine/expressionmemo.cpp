@@ -0,0 +1,73 @@
+/**
+ * Copyright 2019 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include "apl/engine/context.h"
+#include "apl/engine/evaluate.h"
+#include "apl/engine/expressionmemo.h"
+
+namespace apl {
+
+/**
+ * Compare the current versions of the inputs against the recorded versions.  The recorded
+ * versions are brought up to date as a side effect.
+ */
+bool
+ExpressionMemo::inputsChanged(const Context& context)
+{
+    bool changed = !mValid;
+    mVersions.resize(mSymbols.size());
+
+    for (size_t i = 0 ; i < mSymbols.size() ; i++) {
+        auto version = context.version(mSymbols[i]);
+        if (version != mVersions[i]) {
+            mVersions[i] = version;
+            changed = true;
+        }
+    }
+
+    return changed;
+}
+
+void
+ExpressionMemo::seed(const Context& context, const Object& value)
+{
+    inputsChanged(context);
+    mValue = value;
+    mValid = true;
+}
+
+bool
+ExpressionMemo::update(Context& context, const Object& node)
+{
+    auto& stats = context.recalculationStats();
+
+    if (!inputsChanged(context)) {
+        stats.skipped++;
+        return false;
+    }
+
+    auto value = evaluate(context, node);
+    if (mValid && value == mValue) {
+        stats.unchanged++;
+        return false;
+    }
+
+    mValue = std::move(value);
+    mValid = true;
+    stats.changed++;
+    return true;
+}
+
+} // namespace apl
@@ -13,6 +13,9 @@
  * permissions and limitations under the License.
  */
 
+#include <cctype>
+#include <cstring>
+
 #include "apl/common.h"
 #include "apl/command/documentcommand.h"
 #include "apl/component/corecomponent.h"
@@ -51,6 +54,113 @@ KeyboardManager::getHandlerPropertyKey(KeyHandlerType type) {
     return sHandlerProperty.at(type);
 }
 
+/**
+ * Check for a "when" clause of the form "${event.keyboard.code == 'KeyA'}".
+ * @param when The "when" clause.
+ * @param code Set to the key code the clause tests for.
+ * @return True if the clause is exactly a key code test.
+ */
+static bool
+isKeyCodeTest(const Object& when, std::string& code)
+{
+    if (!when.isString())
+        return false;
+
+    const auto& s = when.getString();
+    size_t pos = 0;
+    auto skipSpace = [&]() { while (pos < s.size() && std::isspace(static_cast<unsigned char>(s[pos]))) pos++; };
+    auto match = [&](const char *token) {
+        skipSpace();
+        size_t len = std::strlen(token);
+        if (s.compare(pos, len, token) != 0)
+            return false;
+        pos += len;
+        return true;
+    };
+
+    if (s.compare(0, 2, "${") != 0)
+        return false;
+    pos = 2;
+    if (!match("event.keyboard.code") || !match("=="))
+        return false;
+
+    skipSpace();
+    if (pos >= s.size() || (s[pos] != '\'' && s[pos] != '"'))
+        return false;
+
+    char quote = s[pos++];
+    auto end = s.find(quote, pos);
+    if (end == std::string::npos)
+        return false;
+
+    auto value = s.substr(pos, end - pos);
+    if (value.find_first_of("${}") != std::string::npos)
+        return false;
+
+    pos = end + 1;
+    if (!match("}"))
+        return false;
+    skipSpace();
+    if (pos != s.size())
+        return false;
+
+    code = std::move(value);
+    return true;
+}
+
+KeyHandlerList
+KeyboardManager::compileKeyHandlers(const Context& context, const std::vector<Object>& handlers)
+{
+    // Expressions are folded against the immutable values in the context while they are parsed.
+    // If "event" is already defined it would be folded too, so leave those clauses unparsed.
+    bool canParse = !context.has("event");
+
+    KeyHandlerList result;
+    for (const auto& handler : handlers) {
+        if (!handler.isMap())
+            continue;
+
+        KeyHandler compiled;
+        compiled.handler = handler;
+        compiled.codeOnly = false;
+
+        auto when = handler.get("when");
+        if (when.isNull())
+            when = false;
+        else if (isKeyCodeTest(when, compiled.code))
+            compiled.codeOnly = true;
+        compiled.when = canParse && when.isString() ? parseDataBinding(context, when.getString()) : when;
+
+        auto propagate = handler.get("propagate");
+        if (propagate.isNull())
+            propagate = false;
+        compiled.propagate = canParse && propagate.isString() ? parseDataBinding(context, propagate.getString()) : propagate;
+
+        result.emplace_back(std::move(compiled));
+    }
+
+    return result;
+}
+
+const KeyHandler*
+KeyboardManager::findKeyHandler(const KeyHandlerList& handlers, const Context& eventContext,
+                                const ObjectMap& keyboard)
+{
+    for (const auto& handler : handlers) {
+        if (handler.codeOnly) {
+            auto it = keyboard.find("code");
+            if (it != keyboard.end() && it->second.isString() && it->second.getString() == handler.code)
+                return &handler;
+            continue;
+        }
+
+        if (evaluate(eventContext, handler.when).asBoolean())
+            return &handler;
+    }
+
+    return nullptr;
+}
+
 bool
 KeyboardManager::handleKeyboard(KeyHandlerType type, const CoreComponentPtr& component,
                                 const Keyboard& keyboard, const RootContextPtr& rootContext) {
@@ -87,36 +197,38 @@ bool
 KeyboardManager::executeDocumentKeyHandlers(const RootContextPtr& rootContext, KeyHandlerType type,
                                             const ObjectMapPtr& keyboard) {
 
-    const auto& property = sComponentPropertyBimap.at(getHandlerPropertyKey(type));
     auto handlerId = getHandlerId(type);
 
-    const auto& json = rootContext->content()->getDocument()->json();
-    auto handlers = arrayifyProperty(json, property.c_str());
-    if (handlers.size() == 0) {
+    // The document never changes for the life of the root context, so parse its handlers once
+    auto it = mDocumentHandlers.find(type);
+    if (it == mDocumentHandlers.end()) {
+        const auto& property = sComponentPropertyBimap.at(getHandlerPropertyKey(type));
+        const auto& json = rootContext->content()->getDocument()->json();
+        std::vector<Object> definitions;
+        for (const auto& handler : arrayifyProperty(json, property.c_str()))
+            definitions.emplace_back(handler);
+        it = mDocumentHandlers.emplace(type, compileKeyHandlers(rootContext->context(), definitions)).first;
+    }
+
+    const auto& handlers = it->second;
+    if (handlers.empty()) {
         LOG_IF(DEBUG_KEYBOARD_MANAGER) << " No Document handlers: " << handlerId;
         return false;
     }
 
     ContextPtr eventContext = rootContext->createKeyboardDocumentContext(handlerId, keyboard);
-    bool consumed = false;
-
-    for (const auto& handler : handlers) {
-        auto when = propertyAsBoolean(*eventContext, handler, "when", false);
-        if (!when)
-            continue;
-
-        auto commands = Object(arrayifyProperty(*eventContext, handler, "commands"));
-        if (!commands.empty()) {
-            // execute in normal mode
-            rootContext->executeCommands(commands, false);
-            LOG_IF(DEBUG_KEYBOARD_MANAGER) << "executing document commands: " << commands;
-        }
+    auto handler = findKeyHandler(handlers, *eventContext, *keyboard);
+    if (!handler)
+        return false;
 
-        consumed = !propertyAsBoolean(*eventContext, handler, "propagate", false);
-        break;
+    auto commands = Object(arrayifyProperty(*eventContext, handler->handler, "commands"));
+    if (!commands.empty()) {
+        // execute in normal mode
+        rootContext->executeCommands(commands, false);
+        LOG_IF(DEBUG_KEYBOARD_MANAGER) << "executing document commands: " << commands;
     }
 
-    return consumed;
+    return !evaluate(*eventContext, handler->propagate).asBoolean();
 }
 
 
@@ -84,6 +84,11 @@ Properties::emplace(const Object& item)
     if (!item.isMap())
         return;
 
+    if (item.isJson())
+        mSources.push_back(&item.getJson());
+    else
+        mSourcesKnown = false;
+
     for (const auto& kv : item.getMap()) {
         const std::string name = kv.first;
         if (name == "type" || name == "when")
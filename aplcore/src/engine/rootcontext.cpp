@@ -14,6 +14,7 @@
  */
 
 #include <algorithm>
+#include <chrono>
 
 #include <rapidjson/stringbuffer.h>
 #include <apl/command/documentcommand.h>
@@ -72,7 +73,9 @@ RootContext::create(const Metrics& metrics, const ContentPtr& content,
 
 RootContext::RootContext(const Metrics& metrics, const ContentPtr& content, const RootConfig& config)
     : mContent(content),
-      mTimeManager(config.getTimeManager())
+      mTimeManager(config.getTimeManager()),
+      mVisualContextGeneration(0),
+      mVisualContextValid(false)
 {
     std::string theme = metrics.getTheme();
     const auto& json = content->getDocument()->json();
@@ -163,6 +166,34 @@ RootContext::clearDirty()
     mCore->dirty.clear();
 }
 
+bool
+RootContext::isVisualContextDirty() const
+{
+    assert(mCore);
+    clearPending();
+    return !mVisualContextValid || mVisualContextGeneration != mCore->visualContextGeneration();
+}
+
+rapidjson::Value
+RootContext::serializeVisualContext(rapidjson::Document::AllocatorType& allocator)
+{
+    if (isVisualContextDirty()) {
+        auto top = mCore->mTop;
+        if (!top)
+            return rapidjson::Value(rapidjson::kObjectType);
+
+        // Build into a fresh document so the previous context's memory is released
+        rapidjson::Document doc;
+        auto value = top->serializeVisualContext(doc.GetAllocator());
+        static_cast<rapidjson::Value&>(doc).Swap(value);
+        mVisualContext.Swap(doc);
+        mVisualContextGeneration = mCore->visualContextGeneration();
+        mVisualContextValid = true;
+    }
+
+    return rapidjson::Value(mVisualContext, allocator);
+}
+
 
 std::shared_ptr<ObjectMap>
 RootContext::createDocumentEventProperties(const std::string& handler) const {
@@ -236,6 +267,23 @@ RootContext::updateTime(apl_time_t currentTime, apl_time_t localTime)
     mContext->systemUpdateAndRecalculate(UTC_TIME, localTime - mCore->rootConfig().getLocalTimeAdjustment(), true);
 }
 
+bool
+RootContext::updateTimeWithBudget(apl_time_t currentTime, apl_duration_t budget)
+{
+    auto startTime = mTimeManager->currentTime();
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(budget);
+    bool remaining = mTimeManager->updateTimeWithDeadline(currentTime, deadline);
+
+    auto reachedTime = mTimeManager->currentTime();
+    mContext->systemUpdateAndRecalculate(ELAPSED_TIME, reachedTime, true);
+
+    if (reachedTime > startTime)
+        mLocalTime += reachedTime - startTime;
+    mContext->systemUpdateAndRecalculate(LOCAL_TIME, mLocalTime, true);
+    mContext->systemUpdateAndRecalculate(UTC_TIME, mLocalTime - mCore->rootConfig().getLocalTimeAdjustment(), true);
+    return remaining;
+}
+
 void
 RootContext::scrollToRectInComponent(const ComponentPtr& component, const Rect &bounds,
                                      CommandScrollAlign align) {
@@ -323,46 +371,15 @@ RootContext::setup()
             mCore->styles().addStyleDefinitions(mCore->session(), &styleIter->value, path.addObject("styles"));
     }
 
-    // Layout processing
+    // Layouts, commands, and graphics are extracted when the package is created.  Later packages
+    // in the ordered list override earlier ones.
     for (const auto& child : ordered) {
-        const auto& json = child->json();
-        const auto path = Path(trackProvenance ? child->name() : std::string()).addObject("layouts");
-
-        auto layoutIter = json.FindMember("layouts");
-        if (layoutIter != json.MemberEnd() && layoutIter->value.IsObject()) {
-            for (const auto& kv : layoutIter->value.GetObject()) {
-                const auto& name = kv.name.GetString();
-                mCore->mLayouts[name] = { &kv.value, path.addObject(name) };
-            }
-        }
-    }
-
-    // Command processing
-    for (const auto& child : ordered) {
-        const auto& json = child->json();
-        const auto path = Path(trackProvenance ? child->name() : std::string()).addObject("commands");
-
-        auto commandIter = json.FindMember("commands");
-        if (commandIter != json.MemberEnd() && commandIter->value.IsObject()) {
-            for (const auto& kv : commandIter->value.GetObject()) {
-                const auto& name = kv.name.GetString();
-                mCore->mCommands[name] = { &kv.value, path.addObject(name) };
-            }
-        }
-    }
-
-    // Graphics processing
-    for (const auto& child : ordered) {
-        const auto& json = child->json();
-        const auto path = Path(trackProvenance ? child->name() : std::string()).addObject("graphics");
-
-        auto graphicsIter = json.FindMember("graphics");
-        if (graphicsIter != json.MemberEnd() && graphicsIter->value.IsObject()) {
-            for (const auto& kv : graphicsIter->value.GetObject()) {
-                const auto& name = kv.name.GetString();
-                mCore->mGraphics[name] = { &kv.value, path.addObject(name)};
-            }
-        }
+        for (const auto& kv : child->layouts(trackProvenance))
+            mCore->mLayouts[kv.first] = kv.second;
+        for (const auto& kv : child->commands(trackProvenance))
+            mCore->mCommands[kv.first] = kv.second;
+        for (const auto& kv : child->graphics(trackProvenance))
+            mCore->mGraphics[kv.first] = kv.second;
     }
 
     // Inflate the top component
@@ -453,10 +470,10 @@ RootContext::verifyTypeField(const std::vector<std::shared_ptr<Package>>& ordere
                              bool enforce)
 {
     for(auto& child : ordered) {
-        auto type = child->type().c_str();
-        if (std::strcmp(type, "APML") == 0)
+        const auto type = child->type();
+        if (type == "APML")
             CONSOLE_CTP(mContext)<< child->name() << ": Stop using the APML document format!";
-        else if (std::strcmp(type, "APL") != 0) {
+        else if (type != "APL") {
             CONSOLE_CTP(mContext) << child->name() << ": Document type field should be \"APL\"!";
             if(enforce) {
                 return false;
@@ -498,4 +515,10 @@ RootContext::getSession() const
     return mCore->session();
 }
 
+const RecalculationStats&
+RootContext::getRecalculationStats() const
+{
+    return mCore->recalculationStats();
+}
+
 } // namespace apl
@@ -88,6 +88,8 @@ RootContextData::RootContextData(const Metrics& metrics,
       mTextMeasurement(config.getMeasure()),
       mConfig(config),
       mScreenLockCount(0),
+      mVisualContextGeneration(0),
+      mLayoutGeneration(0),
       mSettings(config),
       mSession(session)
 {
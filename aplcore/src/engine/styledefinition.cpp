@@ -54,12 +54,13 @@ StyleDefinition::get(const ContextPtr& context, const State& state)
 
     LOG_IF(DEBUG_STYLES) << "Constructing style";
     StyleInstancePtr ptr = std::make_shared<StyleInstance>(mStyleProvenance);
+    const bool trackProvenance = !mStyleProvenance.empty();
 
     // Build extensions in order
     for (const auto& sd : mExtends) {
         const StyleInstancePtr estyle = sd->get(context, state);
         for (auto& kv : *estyle)
-            ptr->put(kv.first, kv.second, estyle->provenance(kv.first));
+            ptr->put(kv.first, kv.second, trackProvenance ? estyle->provenance(kv.first) : "");
     }
 
     // Evaluate each block in order
@@ -79,10 +80,21 @@ StyleDefinition::get(const ContextPtr& context, const State& state)
         for (auto& m : block->GetObject()) {
             const char *name = m.name.GetString();
             if (std::strcmp(name, WHEN) != 0 && std::strcmp(name, DESCRIPTION) != 0)
-                ptr->put(name, evaluate(*extendedContext, m.value), path.addObject(name).toString());
+                ptr->put(name, evaluate(*extendedContext, m.value),
+                         trackProvenance ? path.addObject(name).toString() : "");
         }
     }
 
+    // Different states frequently resolve to the same set of values.  Share a single instance so that
+    // components can detect an unchanged style with a pointer comparison.
+    for (const auto& m : mCache) {
+        if (m.second->equivalent(*ptr)) {
+            mCache[state] = m.second;
+            return m.second;
+        }
+    }
+
+    ptr->finalize();
     mCache[state] = ptr;
     return ptr;
 }
@@ -13,6 +13,9 @@
  * permissions and limitations under the License.
  */
 
+#include <algorithm>
+
+#include "apl/component/componentproperties.h"
 #include "apl/engine/styleinstance.h"
 #include "apl/utils/path.h"
 
@@ -31,6 +34,34 @@ StyleInstance::put(const std::string& key, const Object& value, const std::strin
         mProvenance[key] = provenance;
 }
 
+/**
+ * Called once all properties have been added.  Resolve the property names that match component
+ * properties and store them sorted by key.
+ */
+void
+StyleInstance::finalize()
+{
+    mComponentProperties.clear();
+    for (const auto& m : mValue) {
+        auto key = sComponentPropertyBimap.get(m.first, -1);
+        if (key != -1)
+            mComponentProperties.emplace_back(key, &m.second);
+    }
+
+    std::sort(mComponentProperties.begin(), mComponentProperties.end(),
+              [](const std::pair<int, const Object*>& a, const std::pair<int, const Object*>& b) {
+                  return a.first < b.first;
+              });
+}
+
+bool
+StyleInstance::equivalent(const StyleInstance& other) const
+{
+    return mStyleProvenance == other.mStyleProvenance &&
+           mValue == other.mValue &&
+           mProvenance == other.mProvenance;
+}
+
 Object
 StyleInstance::at(const std::string& key) const
 {
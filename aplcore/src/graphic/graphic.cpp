@@ -94,6 +94,7 @@ Graphic::initialize(const ContextPtr& sourceContext,
         const auto& conversionFunc = sBindingFunctions.at(param.type);
         auto value = conversionFunc(*sourceContext, evaluate(*sourceContext, param.defvalue));
         Object parsed;
+        Object parsedValue;    // The result of evaluating "parsed"
 
         // Check if there is an assigned property
         auto it = properties.find(param.name);
@@ -103,7 +104,8 @@ Graphic::initialize(const ContextPtr& sourceContext,
             // If the assigned property is a string, check for data-binding
             if (it->second.isString()) {
                 parsed = parseDataBinding(mInternalContext, it->second.getString());
-                value = conversionFunc(*sourceContext, evaluate(*sourceContext, parsed));
+                parsedValue = evaluate(*sourceContext, parsed);
+                value = conversionFunc(*sourceContext, parsedValue);
             }
             else {
                 value = conversionFunc(*sourceContext, evaluate(*sourceContext, it->second));
@@ -124,13 +126,15 @@ Graphic::initialize(const ContextPtr& sourceContext,
             std::set<std::string> symbols;
             parsed.symbols(symbols);
             auto self = std::static_pointer_cast<Graphic>(shared_from_this());
+            auto memo = std::make_shared<ExpressionMemo>(symbols);
+            memo->seed(*sourceContext, parsedValue);
             for (const auto& symbol : symbols) {
                 auto upstream = sourceContext->findContextContaining(symbol);
                 if (upstream != nullptr)
                     ContextDependant::create(upstream, symbol,
                                              mInternalContext, param.name,
                                              sourceContext,   // The evaluation context is NOT the target context
-                                             parsed, conversionFunc);
+                                             parsed, conversionFunc, memo);
             }
         }
 
@@ -276,7 +280,7 @@ Graphic::addDirtyChild(const GraphicElementPtr& child)
     if (mDirty.emplace(child).second) {
         auto component = mComponent.lock();
         if (component)
-            component->setDirty(kPropertyGraphic);
+            component->setGraphicDirty();
     }
 }
 
@@ -293,4 +297,12 @@ Graphic::serialize(rapidjson::Document::AllocatorType& allocator) const {
     return v;
 }
 
+rapidjson::Value
+Graphic::serializeDirty(rapidjson::Document::AllocatorType& allocator) const {
+    rapidjson::Value v(rapidjson::kArrayType);
+    for (const auto& element : mDirty)
+        v.PushBack(element->serializeDirty(allocator), allocator);
+    return v;
+}
+
 } // namespace apl
\ No newline at end of file
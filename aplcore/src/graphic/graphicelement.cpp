@@ -19,6 +19,7 @@
 #include "apl/graphic/graphic.h"
 #include "apl/graphic/graphicelement.h"
 #include "apl/graphic/graphicdependant.h"
+#include "apl/graphic/graphicpath.h"
 
 #include "apl/utils/session.h"
 
@@ -121,7 +122,9 @@ GraphicElement::setValue(GraphicPropertyKey key, const Object& value, bool useDi
         return false;
 
     mValues.set(key, value);
-    if (useDirtyFlag && mDirtyProperties.emplace(key).second) {
+    if (useDirtyFlag && !mDirtyMask.test(key)) {
+        mDirtyMask.set(key);
+        mDirtyProperties.emplace(key);
         auto graphic = mGraphic.lock();
         if (graphic)
             graphic->addDirtyChild(shared_from_this());
@@ -154,6 +157,30 @@ GraphicElement::serialize(rapidjson::Document::AllocatorType& allocator) const
     return v;
 }
 
+rapidjson::Value
+GraphicElement::serializeDirty(rapidjson::Document::AllocatorType& allocator) const
+{
+    using rapidjson::Value;
+    Value v(rapidjson::kObjectType);
+    v.AddMember("id", getId(), allocator);
+    Value props(rapidjson::kObjectType);
+    for (int key = 0 ; key < kGraphicPropertyKeyCount ; key++) {
+        if (mDirtyMask.test(key))
+            props.AddMember(
+                    rapidjson::StringRef(sGraphicPropertyBimap.at(key).c_str()),   // Long-lived strings
+                    mValues.get(static_cast<GraphicPropertyKey>(key)).serialize(allocator),
+                    allocator);
+    }
+    v.AddMember("props", props.Move(), allocator);
+    return v;
+}
+
+bool
+GraphicElementIdLess::operator()(const GraphicElementPtr& lhs, const GraphicElementPtr& rhs) const
+{
+    return lhs->getId() < rhs->getId();
+}
+
 /**************************************************************************/
 
 class GraphicElementPath : public GraphicElement {
@@ -176,7 +203,22 @@ public:
 
     virtual GraphicElementType getType() const override { return kGraphicElementTypePath; }
 
+    virtual GraphicPathPtr getPath() const override {
+        if (!mPath)
+            mPath = std::make_shared<GraphicPath>(getValue(kGraphicPropertyPathData).getString());
+        return mPath;
+    }
+
 protected:
+    virtual bool setValue(GraphicPropertyKey key, const Object& value, bool useDirtyFlag) override {
+        if (!GraphicElement::setValue(key, value, useDirtyFlag))
+            return false;
+
+        if (key == kGraphicPropertyPathData)
+            mPath = nullptr;  // Parsed again on the next call to getPath()
+        return true;
+    }
+
     virtual const GraphicPropDefSet& propDefSet() const override {
         static GraphicPropDefSet sPathProperties = GraphicPropDefSet()
             .add({
@@ -191,6 +233,9 @@ protected:
 
         return sPathProperties;
     }
+
+private:
+    mutable GraphicPathPtr mPath;  // Cached parse of the path data
 };
 
 /**************************************************************************/
@@ -0,0 +1,528 @@
+/**
+ * Copyright 2019 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+
+#include "apl/graphic/graphicpath.h"
+
+namespace apl {
+
+static const float PI = 3.14159265358979323846f;
+
+/**
+ * A minimal scanner for the SVG path grammar.  Whitespace and commas separate values; numbers
+ * may run together ("1-2.5.5") and arc flags may be written without separators ("a1 1 0 01 1 1").
+ */
+class PathScanner {
+public:
+    explicit PathScanner(const std::string& data) : mPtr(data.c_str()) {}
+
+    void skipSeparators() {
+        while (*mPtr && (std::isspace(static_cast<unsigned char>(*mPtr)) || *mPtr == ','))
+            mPtr++;
+    }
+
+    bool atEnd() {
+        skipSeparators();
+        return *mPtr == 0;
+    }
+
+    /**
+     * @return The next command letter, or 0 if the next token is not a command letter.
+     */
+    char command() {
+        skipSeparators();
+        char c = *mPtr;
+        if (std::isalpha(static_cast<unsigned char>(c)) && c != 'e' && c != 'E') {
+            mPtr++;
+            return c;
+        }
+        return 0;
+    }
+
+    /**
+     * @return True if the next token looks like the start of a number.
+     */
+    bool hasNumber() {
+        skipSeparators();
+        char c = *mPtr;
+        return std::isdigit(static_cast<unsigned char>(c)) || c == '-' || c == '+' || c == '.';
+    }
+
+    bool number(float& result) {
+        skipSeparators();
+        const char *start = mPtr;
+        const char *p = mPtr;
+        if (*p == '-' || *p == '+') p++;
+        bool digits = false;
+        while (std::isdigit(static_cast<unsigned char>(*p))) { p++; digits = true; }
+        if (*p == '.') {
+            p++;
+            while (std::isdigit(static_cast<unsigned char>(*p))) { p++; digits = true; }
+        }
+        if (!digits)
+            return false;
+        if (*p == 'e' || *p == 'E') {
+            const char *q = p + 1;
+            if (*q == '-' || *q == '+') q++;
+            if (std::isdigit(static_cast<unsigned char>(*q))) {
+                while (std::isdigit(static_cast<unsigned char>(*q))) q++;
+                p = q;
+            }
+        }
+        result = static_cast<float>(std::strtod(std::string(start, p).c_str(), nullptr));
+        mPtr = p;
+        return true;
+    }
+
+    bool flag(bool& result) {
+        skipSeparators();
+        if (*mPtr != '0' && *mPtr != '1')
+            return false;
+        result = *mPtr++ == '1';
+        return true;
+    }
+
+private:
+    const char *mPtr;
+};
+
+GraphicPath::GraphicPath(const std::string& pathData)
+    : mBounds(0, 0, 0, 0),
+      mValid(true)
+{
+    parse(pathData);
+    calculateBounds();
+}
+
+int
+GraphicPath::pointCount(GraphicPathCommand command)
+{
+    switch (command) {
+        case kGraphicPathCommandMoveTo:
+        case kGraphicPathCommandLineTo:
+            return 1;
+        case kGraphicPathCommandQuadTo:
+            return 2;
+        case kGraphicPathCommandCubicTo:
+            return 3;
+        case kGraphicPathCommandClose:
+            return 0;
+    }
+    return 0;
+}
+
+void
+GraphicPath::addCommand(GraphicPathCommand command, std::initializer_list<Point> points)
+{
+    mCommands.push_back(command);
+    for (const auto& p : points) {
+        mPoints.push_back(p.getX());
+        mPoints.push_back(p.getY());
+    }
+}
+
+/**
+ * Convert an SVG elliptical arc to cubic bezier segments, following the endpoint to center
+ * parameterization in the SVG specification (appendix F.6).  Each segment spans at most 90 degrees.
+ */
+void
+GraphicPath::addArc(Point start, float rx, float ry, float rotation, bool largeArc, bool sweep, Point end)
+{
+    if (start == end)
+        return;
+
+    rx = std::abs(rx);
+    ry = std::abs(ry);
+    if (rx == 0 || ry == 0) {
+        addCommand(kGraphicPathCommandLineTo, {end});
+        return;
+    }
+
+    float phi = rotation * PI / 180.0f;
+    float cosPhi = std::cos(phi);
+    float sinPhi = std::sin(phi);
+
+    float dx2 = (start.getX() - end.getX()) / 2;
+    float dy2 = (start.getY() - end.getY()) / 2;
+    float x1p = cosPhi * dx2 + sinPhi * dy2;
+    float y1p = -sinPhi * dx2 + cosPhi * dy2;
+
+    // Scale up the radii if they are too small to span the end points
+    float lambda = (x1p * x1p) / (rx * rx) + (y1p * y1p) / (ry * ry);
+    if (lambda > 1) {
+        float s = std::sqrt(lambda);
+        rx *= s;
+        ry *= s;
+    }
+
+    float rx2 = rx * rx;
+    float ry2 = ry * ry;
+    float num = rx2 * ry2 - rx2 * y1p * y1p - ry2 * x1p * x1p;
+    float den = rx2 * y1p * y1p + ry2 * x1p * x1p;
+    float coef = den > 0 && num > 0 ? std::sqrt(num / den) : 0;
+    if (largeArc == sweep)
+        coef = -coef;
+
+    float cxp = coef * rx * y1p / ry;
+    float cyp = -coef * ry * x1p / rx;
+    float cx = cosPhi * cxp - sinPhi * cyp + (start.getX() + end.getX()) / 2;
+    float cy = sinPhi * cxp + cosPhi * cyp + (start.getY() + end.getY()) / 2;
+
+    float theta1 = std::atan2((y1p - cyp) / ry, (x1p - cxp) / rx);
+    float theta2 = std::atan2((-y1p - cyp) / ry, (-x1p - cxp) / rx);
+    float delta = theta2 - theta1;
+    if (sweep && delta < 0)
+        delta += 2 * PI;
+    else if (!sweep && delta > 0)
+        delta -= 2 * PI;
+
+    int segments = static_cast<int>(std::ceil(std::abs(delta) / (PI / 2) - 0.001f));
+    if (segments < 1)
+        segments = 1;
+    float step = delta / segments;
+    float k = 4.0f / 3.0f * std::tan(step / 4);
+
+    auto pointAt = [&](float x, float y) {
+        return Point(cx + cosPhi * rx * x - sinPhi * ry * y,
+                     cy + sinPhi * rx * x + cosPhi * ry * y);
+    };
+
+    float theta = theta1;
+    for (int i = 0 ; i < segments ; i++) {
+        float c1 = std::cos(theta), s1 = std::sin(theta);
+        float c2 = std::cos(theta + step), s2 = std::sin(theta + step);
+        Point p2 = i == segments - 1 ? end : pointAt(c2, s2);
+        addCommand(kGraphicPathCommandCubicTo, {pointAt(c1 - k * s1, s1 + k * c1),
+                                                pointAt(c2 + k * s2, s2 - k * c2),
+                                                p2});
+        theta += step;
+    }
+}
+
+void
+GraphicPath::parse(const std::string& pathData)
+{
+    PathScanner scanner(pathData);
+
+    Point current;
+    Point subpathStart;
+    Point lastControl;       // Last control point of a cubic or quadratic curve
+    char lastCommand = 0;
+    char command = 0;
+
+    while (!scanner.atEnd()) {
+        char next = scanner.command();
+        if (next)
+            command = next;
+        else if (!command || !scanner.hasNumber()) {
+            mValid = false;
+            return;
+        }
+
+        // A path must start with a move
+        if (mCommands.empty() && command != 'M' && command != 'm') {
+            mValid = false;
+            return;
+        }
+
+        bool relative = std::islower(static_cast<unsigned char>(command)) != 0;
+        float ox = relative ? current.getX() : 0;
+        float oy = relative ? current.getY() : 0;
+        float v[7];
+
+        auto read = [&](int count) {
+            for (int i = 0 ; i < count ; i++)
+                if (!scanner.number(v[i]))
+                    return false;
+            return true;
+        };
+
+        switch (std::toupper(static_cast<unsigned char>(command))) {
+            case 'M':
+                if (!read(2)) { mValid = false; return; }
+                current = Point(ox + v[0], oy + v[1]);
+                subpathStart = current;
+                addCommand(kGraphicPathCommandMoveTo, {current});
+                // Subsequent coordinate pairs are implicit line commands
+                command = relative ? 'l' : 'L';
+                break;
+            case 'L':
+                if (!read(2)) { mValid = false; return; }
+                current = Point(ox + v[0], oy + v[1]);
+                addCommand(kGraphicPathCommandLineTo, {current});
+                break;
+            case 'H':
+                if (!read(1)) { mValid = false; return; }
+                current = Point(ox + v[0], current.getY());
+                addCommand(kGraphicPathCommandLineTo, {current});
+                break;
+            case 'V':
+                if (!read(1)) { mValid = false; return; }
+                current = Point(current.getX(), oy + v[0]);
+                addCommand(kGraphicPathCommandLineTo, {current});
+                break;
+            case 'C': {
+                if (!read(6)) { mValid = false; return; }
+                Point c1(ox + v[0], oy + v[1]);
+                lastControl = Point(ox + v[2], oy + v[3]);
+                current = Point(ox + v[4], oy + v[5]);
+                addCommand(kGraphicPathCommandCubicTo, {c1, lastControl, current});
+                break;
+            }
+            case 'S': {
+                if (!read(4)) { mValid = false; return; }
+                Point c1 = current;
+                if (lastCommand == 'C' || lastCommand == 'S')
+                    c1 = current + (current - lastControl);
+                lastControl = Point(ox + v[0], oy + v[1]);
+                current = Point(ox + v[2], oy + v[3]);
+                addCommand(kGraphicPathCommandCubicTo, {c1, lastControl, current});
+                break;
+            }
+            case 'Q':
+                if (!read(4)) { mValid = false; return; }
+                lastControl = Point(ox + v[0], oy + v[1]);
+                current = Point(ox + v[2], oy + v[3]);
+                addCommand(kGraphicPathCommandQuadTo, {lastControl, current});
+                break;
+            case 'T':
+                if (!read(2)) { mValid = false; return; }
+                if (lastCommand == 'Q' || lastCommand == 'T')
+                    lastControl = current + (current - lastControl);
+                else
+                    lastControl = current;
+                current = Point(ox + v[0], oy + v[1]);
+                addCommand(kGraphicPathCommandQuadTo, {lastControl, current});
+                break;
+            case 'A': {
+                bool largeArc, sweep;
+                if (!read(3) || !scanner.flag(largeArc) || !scanner.flag(sweep) ||
+                    !scanner.number(v[3]) || !scanner.number(v[4])) {
+                    mValid = false;
+                    return;
+                }
+                Point end(ox + v[3], oy + v[4]);
+                addArc(current, v[0], v[1], v[2], largeArc, sweep, end);
+                current = end;
+                break;
+            }
+            case 'Z':
+                addCommand(kGraphicPathCommandClose, {});
+                current = subpathStart;
+                // A close command takes no arguments, so it cannot be repeated implicitly
+                lastCommand = 'Z';
+                command = 0;
+                continue;
+            default:
+                mValid = false;
+                return;
+        }
+
+        lastCommand = static_cast<char>(std::toupper(static_cast<unsigned char>(command)));
+        // The implicit line command after a move should not affect curve reflection
+        if (lastCommand == 'L')
+            lastControl = current;
+    }
+}
+
+/**
+ * Extend the range [lo,hi] with the extrema of a one-dimensional bezier curve.
+ * A quadratic curve is passed with p3 == NaN.
+ */
+static void
+extendCubic(float p0, float p1, float p2, float p3, float& lo, float& hi)
+{
+    auto include = [&](float v) {
+        if (v < lo) lo = v;
+        if (v > hi) hi = v;
+    };
+
+    auto evaluate = [&](float t) {
+        float mt = 1 - t;
+        return mt * mt * mt * p0 + 3 * mt * mt * t * p1 + 3 * mt * t * t * p2 + t * t * t * p3;
+    };
+
+    include(p3);
+
+    // Derivative coefficients: a t^2 + b t + c
+    float a = -p0 + 3 * p1 - 3 * p2 + p3;
+    float b = 2 * (p0 - 2 * p1 + p2);
+    float c = p1 - p0;
+
+    if (std::abs(a) < 1e-12f) {
+        if (std::abs(b) > 1e-12f) {
+            float t = -c / b;
+            if (t > 0 && t < 1) include(evaluate(t));
+        }
+        return;
+    }
+
+    float disc = b * b - 4 * a * c;
+    if (disc < 0)
+        return;
+    float root = std::sqrt(disc);
+    float t1 = (-b + root) / (2 * a);
+    float t2 = (-b - root) / (2 * a);
+    if (t1 > 0 && t1 < 1) include(evaluate(t1));
+    if (t2 > 0 && t2 < 1) include(evaluate(t2));
+}
+
+static void
+extendQuad(float p0, float p1, float p2, float& lo, float& hi)
+{
+    if (p2 < lo) lo = p2;
+    if (p2 > hi) hi = p2;
+
+    float den = p0 - 2 * p1 + p2;
+    if (std::abs(den) < 1e-12f)
+        return;
+    float t = (p0 - p1) / den;
+    if (t > 0 && t < 1) {
+        float mt = 1 - t;
+        float v = mt * mt * p0 + 2 * mt * t * p1 + t * t * p2;
+        if (v < lo) lo = v;
+        if (v > hi) hi = v;
+    }
+}
+
+void
+GraphicPath::calculateBounds()
+{
+    if (mCommands.empty())
+        return;
+
+    float minX = mPoints[0], maxX = mPoints[0];
+    float minY = mPoints[1], maxY = mPoints[1];
+    const float *p = mPoints.data();
+    float cx = 0, cy = 0;
+
+    for (auto command : mCommands) {
+        switch (command) {
+            case kGraphicPathCommandMoveTo:
+            case kGraphicPathCommandLineTo:
+                cx = p[0];
+                cy = p[1];
+                if (cx < minX) minX = cx;
+                if (cx > maxX) maxX = cx;
+                if (cy < minY) minY = cy;
+                if (cy > maxY) maxY = cy;
+                break;
+            case kGraphicPathCommandQuadTo:
+                extendQuad(cx, p[0], p[2], minX, maxX);
+                extendQuad(cy, p[1], p[3], minY, maxY);
+                cx = p[2];
+                cy = p[3];
+                break;
+            case kGraphicPathCommandCubicTo:
+                extendCubic(cx, p[0], p[2], p[4], minX, maxX);
+                extendCubic(cy, p[1], p[3], p[5], minY, maxY);
+                cx = p[4];
+                cy = p[5];
+                break;
+            case kGraphicPathCommandClose:
+                break;
+        }
+        p += 2 * pointCount(command);
+    }
+
+    mBounds = Rect(minX, minY, maxX - minX, maxY - minY);
+}
+
+std::vector<std::vector<Point>>
+GraphicPath::flatten(float tolerance) const
+{
+    std::vector<std::vector<Point>> result;
+    if (tolerance <= 0)
+        tolerance = 0.25f;
+
+    const float *p = mPoints.data();
+    Point current;
+    Point start;
+    bool closed = false;
+
+    // A drawing command after a close starts a new sub-path at the start of the closed one
+    auto polyline = [&]() -> std::vector<Point>& {
+        if (closed) {
+            result.emplace_back(1, start);
+            closed = false;
+        }
+        return result.back();
+    };
+
+    for (auto command : mCommands) {
+        switch (command) {
+            case kGraphicPathCommandMoveTo:
+                current = start = Point(p[0], p[1]);
+                result.emplace_back(1, current);
+                closed = false;
+                break;
+            case kGraphicPathCommandLineTo:
+                current = Point(p[0], p[1]);
+                polyline().push_back(current);
+                break;
+            case kGraphicPathCommandQuadTo: {
+                // Wang's formula: the second difference bounds the distance to the chord
+                float ddx = current.getX() - 2 * p[0] + p[2];
+                float ddy = current.getY() - 2 * p[1] + p[3];
+                float dd = std::sqrt(ddx * ddx + ddy * ddy);
+                int n = std::max(1, static_cast<int>(std::ceil(std::sqrt(0.25f * dd / tolerance))));
+                auto& line = polyline();
+                for (int i = 1 ; i <= n ; i++) {
+                    float t = static_cast<float>(i) / n;
+                    float mt = 1 - t;
+                    line.emplace_back(mt * mt * current.getX() + 2 * mt * t * p[0] + t * t * p[2],
+                                      mt * mt * current.getY() + 2 * mt * t * p[1] + t * t * p[3]);
+                }
+                current = Point(p[2], p[3]);
+                line.back() = current;
+                break;
+            }
+            case kGraphicPathCommandCubicTo: {
+                float ddx1 = current.getX() - 2 * p[0] + p[2];
+                float ddy1 = current.getY() - 2 * p[1] + p[3];
+                float ddx2 = p[0] - 2 * p[2] + p[4];
+                float ddy2 = p[1] - 2 * p[3] + p[5];
+                float dd = std::sqrt(std::max(ddx1 * ddx1 + ddy1 * ddy1, ddx2 * ddx2 + ddy2 * ddy2));
+                int n = std::max(1, static_cast<int>(std::ceil(std::sqrt(0.75f * dd / tolerance))));
+                auto& line = polyline();
+                for (int i = 1 ; i <= n ; i++) {
+                    float t = static_cast<float>(i) / n;
+                    float mt = 1 - t;
+                    float a = mt * mt * mt, b = 3 * mt * mt * t, c = 3 * mt * t * t, d = t * t * t;
+                    line.emplace_back(a * current.getX() + b * p[0] + c * p[2] + d * p[4],
+                                      a * current.getY() + b * p[1] + c * p[3] + d * p[5]);
+                }
+                current = Point(p[4], p[5]);
+                line.back() = current;
+                break;
+            }
+            case kGraphicPathCommandClose:
+                if (!closed)
+                    result.back().push_back(start);
+                current = start;
+                closed = true;
+                break;
+        }
+        p += 2 * pointCount(command);
+    }
+
+    return result;
+}
+
+} // namespace apl
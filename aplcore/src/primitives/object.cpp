@@ -610,7 +610,7 @@ Object::Object(const rapidjson::Value& value)
         break;
     case rapidjson::kStringType:
         mType = kStringType;
-        mString = value.GetString();  // TODO: Should we keep the string in place?
+        mString.assign(value.GetString(), value.GetStringLength());  // Strings are copied; they may outlive the document
         break;
     case rapidjson::kObjectType:
         mType = kMapType;
@@ -751,8 +751,8 @@ Object::operator==(const Object& rhs) const
             if (mData->size() != rhs.mData->size())
                 return false;
 
-            auto left = mData->getMap();
-            auto right = rhs.mData->getMap();
+            const auto& left = mData->getMap();
+            const auto& right = rhs.mData->getMap();
             for (auto& m : left) {
                 auto it = right.find(m.first);
                 if (it == right.end())
@@ -767,8 +767,8 @@ Object::operator==(const Object& rhs) const
             if (mData->size() != rhs.mData->size())
                 return false;
 
-            auto left = mData->getArray();
-            auto right = rhs.mData->getArray();
+            const auto& left = mData->getArray();
+            const auto& right = rhs.mData->getArray();
             for (int i = 0 ; i < mData->size() ; i++)
                 if (left.at(i) != right.at(i))
                     return false;
@@ -1119,6 +1119,13 @@ Object::empty() const
     }
 }
 
+const datagrammar::Node&
+Object::getNode() const
+{
+    assert(mType == kNodeType);
+    return static_cast<const datagrammar::Node&>(*mData);
+}
+
 Object
 Object::eval(const Context& context) const
 {
@@ -1158,7 +1165,7 @@ Object::serialize(rapidjson::Document::AllocatorType& allocator) const
         case kNumberType:
             return rapidjson::Value(mValue);
         case kStringType:
-            return rapidjson::Value(mString.c_str(), allocator);
+            return rapidjson::Value(mString.c_str(), mString.size(), allocator);
         case kArrayType: {
             rapidjson::Value v(rapidjson::kArrayType);
             for (int i = 0 ; i < size() ; i++)
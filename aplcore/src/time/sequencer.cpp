@@ -41,9 +41,9 @@ Sequencer::execute(const CommandPtr& commandPtr, bool fastMode)
 
     if (fastMode) {
         if (ptr && ptr->isPending()) {
-            mOneShotSet.emplace(ptr);
+            mOneShots.push_back(ptr);
             ptr->then([this](const ActionPtr& ptr) {
-                mOneShotSet.erase(ptr);
+                mOneShots.remove(ptr.get());
             });
         }
         ptr = nullptr;  // We never return the ActionPtr for fast mode
@@ -69,9 +69,6 @@ Sequencer::executeCommands(const Object& commands,
     if (commands.empty())
         return nullptr;
 
-    if (!context->has("event") && !fastMode)
-        LOG(LogLevel::WARN) << "missing event in context";
-
     Properties props;
     auto commandPtr = ArrayCommand::create(context, commands, baseComponent, props);
     return execute(commandPtr, fastMode);
@@ -83,7 +80,7 @@ Sequencer::terminate()
     LOG_IF(DEBUG_SEQUENCER) << "Sequencer terminate";
 
     reset();
-    mOneShotSet.clear();
+    mOneShots.clear();
     mTerminated = false;
 }
 
@@ -0,0 +1,115 @@
+/**
+ * Copyright 2019 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "apl/component/componentproperties.h"
+
+using namespace apl;
+
+void
+usage(const std::string& msg="")
+{
+    if (!msg.empty())
+        std::cout << msg << std::endl;
+    std::cout << "Usage: benchBimap [options]" << std::endl
+              << std::endl
+              << "  Time name-to-property and property-to-name lookups in the component property" << std::endl
+              << "  bimap against a pair of ordered maps holding the same entries." << std::endl
+              << std::endl
+              << "Options: " << std::endl
+              << "  -h | --help               Print this help" << std::endl
+              << "  -r | --repeat COUNT       Number of passes (defaults to 10000)" << std::endl;
+    exit(1);
+}
+
+template<class F>
+static double
+nanosPerLookup(unsigned long repeat, size_t n, F func)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned long i = 0 ; i < repeat ; i++)
+        func();
+    auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start);
+    return elapsed.count() / (repeat * n);
+}
+
+int
+main(int argc, char *argv[]) {
+    unsigned long repeat = 10000;
+
+    std::vector<std::string> args(argv + 1, argv + argc);
+    for (auto iter = args.begin(); iter != args.end();) {
+        if (*iter == "-h" || *iter == "--help")
+            usage("");
+
+        if (*iter == "-r" || *iter == "--repeat") {
+            iter = args.erase(iter);
+            if (iter == args.end())
+                usage("repeat count expects a value");
+            repeat = std::stoul(*iter);
+            iter = args.erase(iter);
+        } else {
+            usage("Unknown argument '" + *iter + "'");
+        }
+    }
+
+    if (repeat == 0)
+        usage("repeat must be positive");
+
+    // The previous implementation: one ordered map in each direction
+    std::map<int, std::string> keyToName;
+    std::map<std::string, int> nameToKey;
+    std::vector<int> keys;
+    std::vector<std::string> names;
+    for (auto it = sComponentPropertyBimap.begin() ; it != sComponentPropertyBimap.end() ; ++it) {
+        keyToName.emplace(it->first, it->second);
+        nameToKey.emplace(it->second, it->first);
+        keys.push_back(it->first);
+        names.push_back(it->second);
+    }
+
+    size_t n = keys.size();
+    volatile size_t sink = 0;
+
+    auto mapNameTime = nanosPerLookup(repeat, n, [&]() {
+        for (const auto& name : names)
+            sink = sink + nameToKey.at(name);
+    });
+
+    auto bimapNameTime = nanosPerLookup(repeat, n, [&]() {
+        for (const auto& name : names)
+            sink = sink + sComponentPropertyBimap.at(name);
+    });
+
+    auto mapKeyTime = nanosPerLookup(repeat, n, [&]() {
+        for (auto key : keys)
+            sink = sink + keyToName.at(key).size();
+    });
+
+    auto bimapKeyTime = nanosPerLookup(repeat, n, [&]() {
+        for (auto key : keys)
+            sink = sink + sComponentPropertyBimap.at(key).size();
+    });
+
+    std::cout << "entries=" << n << std::endl
+              << "name->key map=" << mapNameTime << "ns bimap=" << bimapNameTime << "ns" << std::endl
+              << "key->name map=" << mapKeyTime << "ns bimap=" << bimapKeyTime << "ns" << std::endl;
+    return 0;
+}
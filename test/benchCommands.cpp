@@ -0,0 +1,149 @@
+/**
+ * Copyright 2019 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "apl/apl.h"
+
+using namespace apl;
+
+// Count heap allocations so that the per-command cost of the command runtime is visible
+static std::atomic<long> sAllocations(0);
+
+void *
+operator new(std::size_t size)
+{
+    sAllocations++;
+    if (auto ptr = std::malloc(size ? size : 1))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void
+operator delete(void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void
+usage(const std::string& msg="")
+{
+    if (!msg.empty())
+        std::cout << msg << std::endl;
+    std::cout << "Usage: benchCommands [options]" << std::endl
+              << std::endl
+              << "  Run a Sequential command made of SetValue commands and report the number of" << std::endl
+              << "  commands executed per second and heap allocations per command." << std::endl
+              << std::endl
+              << "Options: " << std::endl
+              << "  -h | --help               Print this help" << std::endl
+              << "  -c | --commands COUNT     Number of SetValue commands in the sequence (defaults to 10)" << std::endl
+              << "  -r | --repeat COUNT       Repeat count of the sequence (defaults to 1000)" << std::endl
+              << "  -p | --passes COUNT       Number of times the command is executed (defaults to 10)" << std::endl;
+    exit(1);
+}
+
+static const char *DOCUMENT =
+    "{"
+    "  \"type\": \"APL\","
+    "  \"version\": \"1.1\","
+    "  \"mainTemplate\": {"
+    "    \"item\": {"
+    "      \"type\": \"Text\","
+    "      \"id\": \"target\","
+    "      \"bind\": { \"name\": \"counter\", \"value\": 0 },"
+    "      \"text\": \"${counter}\""
+    "    }"
+    "  }"
+    "}";
+
+int
+main(int argc, char *argv[]) {
+    int commandCount = 10;
+    int repeatCount = 1000;
+    int passes = 10;
+
+    std::vector<std::string> args(argv + 1, argv + argc);
+    for (auto iter = args.begin(); iter != args.end();) {
+        if (*iter == "-h" || *iter == "--help")
+            usage("");
+
+        int *target = nullptr;
+        if (*iter == "-c" || *iter == "--commands")
+            target = &commandCount;
+        else if (*iter == "-r" || *iter == "--repeat")
+            target = &repeatCount;
+        else if (*iter == "-p" || *iter == "--passes")
+            target = &passes;
+        else
+            usage("Unknown argument '" + *iter + "'");
+
+        iter = args.erase(iter);
+        if (iter == args.end())
+            usage("missing value");
+        *target = std::stoi(*iter);
+        iter = args.erase(iter);
+    }
+
+    if (commandCount <= 0 || repeatCount < 0 || passes <= 0)
+        usage("invalid count");
+
+    auto content = Content::create(DOCUMENT);
+    Metrics metrics = Metrics().size(1024, 800);
+    auto root = RootContext::create(metrics, content);
+    if (!root) {
+        std::cout << "Unable to inflate the document" << std::endl;
+        return 1;
+    }
+
+    std::string json = "[{\"type\": \"Sequential\", \"repeatCount\": " + std::to_string(repeatCount) +
+                       ", \"commands\": [";
+    for (int i = 0 ; i < commandCount ; i++) {
+        if (i)
+            json += ",";
+        json += "{\"type\": \"SetValue\", \"componentId\": \"target\", \"property\": \"counter\", "
+                "\"value\": " + std::to_string(i) + "}";
+    }
+    json += "]}]";
+
+    rapidjson::Document doc;
+    doc.Parse(json.c_str());
+
+    double executed = static_cast<double>(commandCount) * (repeatCount + 1) * passes;
+    auto allocations = sAllocations.load();
+    auto start = std::chrono::steady_clock::now();
+    for (int pass = 0 ; pass < passes ; pass++) {
+        auto action = root->executeCommands(Object(doc), false);
+        while (action && action->isPending())
+            root->updateTime(root->currentTime() + 1);
+        root->clearDirty();
+    }
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    allocations = sAllocations.load() - allocations;
+
+    auto text = root->topComponent()->getCalculated(kPropertyText).getStyledText().asString();
+    std::cout << "commands=" << static_cast<long>(executed)
+              << " seconds=" << elapsed
+              << " commands/second=" << static_cast<long>(executed / elapsed)
+              << " allocations/command=" << allocations / executed
+              << " final=" << text << std::endl;
+    return 0;
+}
@@ -0,0 +1,172 @@
+/**
+ * Copyright 2019 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "apl/apl.h"
+
+using namespace apl;
+
+void
+usage(const std::string& msg="")
+{
+    if (!msg.empty())
+        std::cout << msg << std::endl;
+    std::cout << "Usage: benchComponentId [options]" << std::endl
+              << std::endl
+              << "  Inflate a document with many components and time component identity lookups," << std::endl
+              << "  dirty serialization and event property creation." << std::endl
+              << std::endl
+              << "Options: " << std::endl
+              << "  -h | --help               Print this help" << std::endl
+              << "  -n | --components COUNT   Number of components in the document (defaults to 500)" << std::endl
+              << "  -r | --repeat COUNT       Number of passes (defaults to 100)" << std::endl;
+    exit(1);
+}
+
+static const char *DOCUMENT =
+    "{"
+    "  \"type\": \"APL\","
+    "  \"version\": \"1.1\","
+    "  \"mainTemplate\": {"
+    "    \"parameters\": [ \"payload\" ],"
+    "    \"item\": {"
+    "      \"type\": \"Container\","
+    "      \"data\": \"${payload}\","
+    "      \"items\": {"
+    "        \"type\": \"Frame\","
+    "        \"width\": 10,"
+    "        \"height\": 10"
+    "      }"
+    "    }"
+    "  }"
+    "}";
+
+template<class F>
+static double
+nanosPerItem(unsigned long repeat, size_t n, F func)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned long i = 0 ; i < repeat ; i++)
+        func();
+    auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start);
+    return elapsed.count() / (repeat * n);
+}
+
+int
+main(int argc, char *argv[]) {
+    unsigned long repeat = 100;
+    size_t count = 500;
+
+    std::vector<std::string> args(argv + 1, argv + argc);
+    for (auto iter = args.begin(); iter != args.end();) {
+        if (*iter == "-h" || *iter == "--help")
+            usage("");
+
+        if (*iter == "-n" || *iter == "--components") {
+            iter = args.erase(iter);
+            if (iter == args.end())
+                usage("component count expects a value");
+            count = std::stoul(*iter);
+            iter = args.erase(iter);
+        } else if (*iter == "-r" || *iter == "--repeat") {
+            iter = args.erase(iter);
+            if (iter == args.end())
+                usage("repeat count expects a value");
+            repeat = std::stoul(*iter);
+            iter = args.erase(iter);
+        } else {
+            usage("Unknown argument '" + *iter + "'");
+        }
+    }
+
+    if (count == 0 || repeat == 0)
+        usage("components and repeat must be positive");
+
+    std::string payload = "[";
+    for (size_t i = 0 ; i < count ; i++)
+        payload += (i ? "," : "") + std::to_string(i);
+    payload += "]";
+
+    auto content = Content::create(DOCUMENT);
+    content->addData("payload", payload);
+    if (!content->isReady()) {
+        std::cout << "Unable to load the document" << std::endl;
+        return 1;
+    }
+
+    Metrics metrics = Metrics().size(1024, 800);
+    auto root = RootContext::create(metrics, content);
+    if (!root) {
+        std::cout << "Unable to inflate the document" << std::endl;
+        return 1;
+    }
+
+    auto top = std::static_pointer_cast<CoreComponent>(root->topComponent());
+    std::vector<CoreComponentPtr> components;
+    std::vector<std::string> stringIds;   // The stored string form the components used to carry
+    for (size_t i = 0 ; i < top->getChildCount() ; i++) {
+        auto child = std::static_pointer_cast<CoreComponent>(top->getChildAt(i));
+        components.push_back(child);
+        stringIds.push_back(child->getUniqueId());
+    }
+
+    size_t n = components.size();
+    volatile size_t sink = 0;
+
+    // Identity: find each component in the list by comparing ids
+    auto stringTime = nanosPerItem(repeat, n, [&]() {
+        for (size_t i = 0 ; i < n ; i += 7) {
+            const auto& target = stringIds[i];
+            for (size_t j = 0 ; j < n ; j++)
+                if (stringIds[j] == target) { sink = sink + j; break; }
+        }
+    });
+
+    auto numberTime = nanosPerItem(repeat, n, [&]() {
+        for (size_t i = 0 ; i < n ; i += 7) {
+            auto target = components[i]->getUniqueIdNumber();
+            for (size_t j = 0 ; j < n ; j++)
+                if (components[j]->getUniqueIdNumber() == target) { sink = sink + j; break; }
+        }
+    });
+
+    // Dirty serialization: change every component and serialize the changes
+    rapidjson::Document doc;
+    double opacity = 0.5;
+    auto dirtyTime = nanosPerItem(repeat, n, [&]() {
+        opacity = 1.5 - opacity;
+        for (auto& c : components)
+            c->setProperty(kPropertyOpacity, opacity);
+        for (const auto& c : root->getDirty())
+            sink = sink + c->serializeDirty(doc.GetAllocator()).MemberCount();
+        root->clearDirty();
+    });
+
+    // Event properties for each component
+    auto eventTime = nanosPerItem(repeat, n, [&]() {
+        for (auto& c : components)
+            sink = sink + c->getEventTargetProperties()->size();
+    });
+
+    std::cout << "components=" << n << std::endl
+              << "identity string=" << stringTime << "ns number=" << numberTime << "ns" << std::endl
+              << "serializeDirty=" << dirtyTime << "ns" << std::endl
+              << "eventTarget=" << eventTime << "ns" << std::endl;
+    return 0;
+}
@@ -0,0 +1,133 @@
+/**
+ * Copyright 2019 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "apl/apl.h"
+
+using namespace apl;
+
+void
+usage(const std::string& msg="")
+{
+    if (!msg.empty())
+        std::cout << msg << std::endl;
+    std::cout << "Usage: benchDependant [options]" << std::endl
+              << std::endl
+              << "  Inflate a document with many data-bound Text components and time SetValue-style" << std::endl
+              << "  updates of the bound values.  Most updates don't change the rendered text." << std::endl
+              << std::endl
+              << "Options: " << std::endl
+              << "  -h | --help               Print this help" << std::endl
+              << "  -n | --components COUNT   Number of components in the document (defaults to 200)" << std::endl
+              << "  -r | --repeat COUNT       Number of updates (defaults to 1000)" << std::endl;
+    exit(1);
+}
+
+// Each Text shows a coarse bucket of "counter" and also depends on "counter" through "scaled"
+static const char *DOCUMENT =
+    "{"
+    "  \"type\": \"APL\","
+    "  \"version\": \"1.1\","
+    "  \"mainTemplate\": {"
+    "    \"parameters\": [ \"payload\" ],"
+    "    \"item\": {"
+    "      \"type\": \"Container\","
+    "      \"bind\": ["
+    "        { \"name\": \"counter\", \"value\": 0 },"
+    "        { \"name\": \"scaled\", \"value\": \"${Math.floor(counter / 100)}\" }"
+    "      ],"
+    "      \"data\": \"${payload}\","
+    "      \"items\": {"
+    "        \"type\": \"Text\","
+    "        \"text\": \"Item ${data}: ${scaled} of ${Math.floor(counter / 100)}\","
+    "        \"color\": \"${counter % 2 == 0 ? 'red' : 'blue'}\""
+    "      }"
+    "    }"
+    "  }"
+    "}";
+
+int
+main(int argc, char *argv[]) {
+    unsigned long repeat = 1000;
+    size_t count = 200;
+
+    std::vector<std::string> args(argv + 1, argv + argc);
+    for (auto iter = args.begin(); iter != args.end();) {
+        if (*iter == "-h" || *iter == "--help")
+            usage("");
+
+        if (*iter == "-n" || *iter == "--components") {
+            iter = args.erase(iter);
+            if (iter == args.end())
+                usage("component count expects a value");
+            count = std::stoul(*iter);
+            iter = args.erase(iter);
+        } else if (*iter == "-r" || *iter == "--repeat") {
+            iter = args.erase(iter);
+            if (iter == args.end())
+                usage("repeat count expects a value");
+            repeat = std::stoul(*iter);
+            iter = args.erase(iter);
+        } else {
+            usage("Unknown argument '" + *iter + "'");
+        }
+    }
+
+    if (count == 0 || repeat == 0)
+        usage("components and repeat must be positive");
+
+    std::string payload = "[";
+    for (size_t i = 0 ; i < count ; i++)
+        payload += (i ? "," : "") + std::to_string(i);
+    payload += "]";
+
+    auto content = Content::create(DOCUMENT);
+    content->addData("payload", payload);
+    if (!content->isReady()) {
+        std::cout << "Unable to load the document" << std::endl;
+        return 1;
+    }
+
+    Metrics metrics = Metrics().size(1024, 800);
+    auto root = RootContext::create(metrics, content);
+    if (!root) {
+        std::cout << "Unable to inflate the document" << std::endl;
+        return 1;
+    }
+
+    auto context = root->topComponent()->getContext();
+
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned long i = 1 ; i <= repeat ; i++) {
+        context->userUpdateAndRecalculate("counter", static_cast<double>(i), true);
+        root->clearDirty();
+    }
+    auto elapsed = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start);
+
+    const auto& stats = root->getRecalculationStats();
+    auto total = stats.total();
+    std::cout << "components=" << count << " updates=" << repeat << std::endl
+              << "update=" << elapsed.count() / repeat << "us" << std::endl
+              << "recalculations=" << total
+              << " skipped=" << stats.skipped
+              << " unchanged=" << stats.unchanged
+              << " changed=" << stats.changed << std::endl
+              << "hit rate=" << (total ? 100.0 * (stats.skipped + stats.unchanged) / total : 0) << "%" << std::endl;
+    return 0;
+}
@@ -0,0 +1,189 @@
+/**
+ * Copyright 2019 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "apl/animation/coreeasing.h"
+
+using namespace apl;
+
+void
+usage(const std::string& msg="")
+{
+    if (!msg.empty())
+        std::cout << msg << std::endl;
+    std::cout << "Usage: benchEasing [options]" << std::endl
+              << std::endl
+              << "  Time the cubic-bezier easing curves against a bisection reference and" << std::endl
+              << "  check the maximum error against an exact double-precision solution." << std::endl
+              << "  Returns a non-zero exit code if the error bound is exceeded." << std::endl
+              << std::endl
+              << "Options: " << std::endl
+              << "  -h | --help               Print this help" << std::endl
+              << "  -n | --samples COUNT      Number of times evaluated per pass (defaults to 1000)" << std::endl
+              << "  -r | --repeat COUNT       Number of passes (defaults to 1000)" << std::endl
+              << "  -e | --error BOUND        Maximum allowed error (defaults to 0.00002)" << std::endl;
+    exit(1);
+}
+
+/**
+ * The original bisection solver, kept for comparison.
+ */
+static float
+bisection(float a, float b, float c, float d, float t)
+{
+    if (t <= 0) return 0;
+    if (t >= 1) return 1;
+
+    float left = 0;
+    float right = 1;
+
+    while (left < right) {
+        float mid = (left + right) / 2;
+        float t_estimate = CubicBezierEasing::f(a, c, mid);
+        if (std::fabs(t - t_estimate) < 0.00001)
+            return CubicBezierEasing::f(b, d, mid);
+
+        if (t_estimate < t)
+            left = mid;
+        else
+            right = mid;
+    }
+    return CubicBezierEasing::f(b, d, left);
+}
+
+static double
+exact(double a, double b, double c, double d, double t)
+{
+    auto f = [](double p, double q, double s) { return s*(3*(1-s)*(p*(1-s)+q*s) + s*s); };
+    double left = 0, right = 1;
+    for (int i = 0 ; i < 60 ; i++) {
+        double mid = (left + right) / 2;
+        if (f(a, c, mid) < t)
+            left = mid;
+        else
+            right = mid;
+    }
+    return f(b, d, (left + right) / 2);
+}
+
+template<class F>
+static double
+nanosPerEval(unsigned long repeat, size_t n, F func)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned long i = 0 ; i < repeat ; i++)
+        func();
+    auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start);
+    return elapsed.count() / (repeat * n);
+}
+
+int
+main(int argc, char *argv[]) {
+    unsigned long repeat = 1000;
+    size_t samples = 1000;
+    double bound = 0.00002;
+
+    std::vector<std::string> args(argv + 1, argv + argc);
+    for (auto iter = args.begin(); iter != args.end();) {
+        if (*iter == "-h" || *iter == "--help")
+            usage("");
+
+        if (*iter == "-n" || *iter == "--samples") {
+            iter = args.erase(iter);
+            if (iter == args.end())
+                usage("samples expects a value");
+            samples = std::stoul(*iter);
+            iter = args.erase(iter);
+        } else if (*iter == "-r" || *iter == "--repeat") {
+            iter = args.erase(iter);
+            if (iter == args.end())
+                usage("repeat count expects a value");
+            repeat = std::stoul(*iter);
+            iter = args.erase(iter);
+        } else if (*iter == "-e" || *iter == "--error") {
+            iter = args.erase(iter);
+            if (iter == args.end())
+                usage("error expects a value");
+            bound = std::stod(*iter);
+            iter = args.erase(iter);
+        } else {
+            usage("Unknown argument '" + *iter + "'");
+        }
+    }
+
+    if (samples == 0 || repeat == 0)
+        usage("samples and repeat must be positive");
+
+    struct Curve { const char *name; float a, b, c, d; };
+    std::vector<Curve> curves = {
+        {"ease",        0.25, 0.10, 0.25, 1},
+        {"ease-in",     0.42, 0,    1,    1},
+        {"ease-out",    0,    0,    0.58, 1},
+        {"ease-in-out", 0.42, 0,    0.58, 1},
+    };
+
+    std::vector<float> times(samples);
+    for (size_t i = 0 ; i < samples ; i++)
+        times[i] = static_cast<float>(i) / (samples - 1 > 0 ? samples - 1 : 1);
+
+    std::vector<float> out(samples);
+    bool failed = false;
+    volatile float sink = 0;
+
+    for (const auto& c : curves) {
+        CubicBezierEasing curve(c.a, c.b, c.c, c.d);
+
+        double oldError = 0, newError = 0;
+        for (auto t : times) {
+            double expected = exact(c.a, c.b, c.c, c.d, t);
+            oldError = std::max(oldError, std::fabs(bisection(c.a, c.b, c.c, c.d, t) - expected));
+            newError = std::max(newError, std::fabs(curve.calc(t) - expected));
+        }
+
+        auto oldTime = nanosPerEval(repeat, samples, [&]() {
+            for (size_t i = 0 ; i < samples ; i++)
+                out[i] = bisection(c.a, c.b, c.c, c.d, times[i]);
+            sink = sink + out[0];
+        });
+
+        auto newTime = nanosPerEval(repeat, samples, [&]() {
+            for (size_t i = 0 ; i < samples ; i++)
+                out[i] = curve.calc(times[i]);
+            sink = sink + out[0];
+        });
+
+        auto batchTime = nanosPerEval(repeat, samples, [&]() {
+            curve.calc(times.data(), out.data(), samples);
+            sink = sink + out[0];
+        });
+
+        std::cout << c.name
+                  << " bisection=" << oldTime << "ns (max error " << oldError << ")"
+                  << " sampled=" << newTime << "ns"
+                  << " batch=" << batchTime << "ns (max error " << newError << ")" << std::endl;
+
+        if (newError > bound) {
+            std::cout << "  error bound " << bound << " exceeded" << std::endl;
+            failed = true;
+        }
+    }
+
+    return failed ? 1 : 0;
+}
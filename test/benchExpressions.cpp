@@ -0,0 +1,227 @@
+/**
+ * Copyright 2019 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "apl/apl.h"
+#include "apl/datagrammar/bytecode.h"
+#include "apl/engine/evaluate.h"
+
+using namespace apl;
+
+void
+usage(const std::string& msg="")
+{
+    if (!msg.empty())
+        std::cout << msg << std::endl;
+    std::cout << "Usage: benchExpressions [options]" << std::endl
+              << std::endl
+              << "  Parse and evaluate a set of data-binding expressions typical of APL documents." << std::endl
+              << "  Expressions reference mutable data so they are not folded at parse time." << std::endl
+              << "  Evaluation is timed with both the node tree and the bytecode backend." << std::endl
+              << "  Parse throughput is measured over a corpus of data-binding strings." << std::endl
+              << std::endl
+              << "Options: " << std::endl
+              << "  -h | --help               Print this help" << std::endl
+              << "  -f | --file FILE          Use the data-binding strings of a JSON document as the parse corpus" << std::endl
+              << "  -r | --repeat COUNT       Number of passes (defaults to 20000)" << std::endl
+              << "  -v | --verbose            Print the time and result of each expression" << std::endl;
+    exit(1);
+}
+
+static const std::vector<std::string> EXPRESSIONS = {
+    "${data.title}",
+    "${data.textContent.primaryText.text}",
+    "${data.image.sources[0].url}",
+    "Item ${index + 1} of ${length}",
+    "${ordinal}. ${data.title} - ${data.subtitle}",
+    "${data.firstName} ${data.lastName}",
+    "${data.width > 960 ? 40 : 20}",
+    "${index % 2 == 0 ? 'even' : 'odd'}",
+    "${data.selected && data.enabled}",
+    "${data.missing || 'No subtitle'}",
+    "${data.missing ?? data.title}",
+    "${Math.max(0, data.count - 1)}",
+    "${String.toUpperCase(data.title)}",
+    "${data.count > 0 && data.textContent.primaryText.text != '' ? 'Has ${data.count} items' : 'Empty'}",
+};
+
+static const char *DATA =
+    "{"
+    "  \"title\": \"Hello world\","
+    "  \"subtitle\": \"A subtitle\","
+    "  \"firstName\": \"Pat\","
+    "  \"lastName\": \"Smith\","
+    "  \"width\": 1024,"
+    "  \"count\": 5,"
+    "  \"selected\": true,"
+    "  \"enabled\": true,"
+    "  \"textContent\": { \"primaryText\": { \"type\": \"PlainText\", \"text\": \"Primary\" } },"
+    "  \"image\": { \"sources\": [ { \"url\": \"https://example.com/a.png\", \"size\": \"small\" } ] }"
+    "}";
+
+// Collect every string in a JSON value that contains data-binding
+static void
+extractCorpus(const rapidjson::Value& value, std::vector<std::string>& corpus)
+{
+    if (value.IsString()) {
+        std::string s(value.GetString(), value.GetStringLength());
+        if (s.find("${") != std::string::npos)
+            corpus.emplace_back(std::move(s));
+    }
+    else if (value.IsArray()) {
+        for (const auto& m : value.GetArray())
+            extractCorpus(m, corpus);
+    }
+    else if (value.IsObject()) {
+        for (const auto& m : value.GetObject())
+            extractCorpus(m.value, corpus);
+    }
+}
+
+template<class F>
+static double
+nanosPerItem(unsigned long repeat, size_t n, F func)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned long i = 0 ; i < repeat ; i++)
+        func();
+    auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start);
+    return elapsed.count() / (repeat * n);
+}
+
+int
+main(int argc, char *argv[]) {
+    unsigned long repeat = 20000;
+    bool verbose = false;
+    std::string corpusFile;
+
+    std::vector<std::string> args(argv + 1, argv + argc);
+    for (auto iter = args.begin(); iter != args.end();) {
+        if (*iter == "-h" || *iter == "--help")
+            usage("");
+
+        if (*iter == "-r" || *iter == "--repeat") {
+            iter = args.erase(iter);
+            if (iter == args.end())
+                usage("repeat count expects a value");
+            repeat = std::stoul(*iter);
+            iter = args.erase(iter);
+        } else if (*iter == "-f" || *iter == "--file") {
+            iter = args.erase(iter);
+            if (iter == args.end())
+                usage("file expects a value");
+            corpusFile = *iter;
+            iter = args.erase(iter);
+        } else if (*iter == "-v" || *iter == "--verbose") {
+            verbose = true;
+            iter = args.erase(iter);
+        } else {
+            usage("Unknown argument '" + *iter + "'");
+        }
+    }
+
+    if (repeat == 0)
+        usage("repeat must be positive");
+
+    rapidjson::Document doc;
+    doc.Parse(DATA);
+
+    auto context = Context::create(Metrics().size(1024, 800), makeDefaultSession());
+    context->putUserWriteable("data", Object(doc));
+    context->putUserWriteable("index", 2);
+    context->putUserWriteable("ordinal", 3);
+    context->putUserWriteable("length", 10);
+
+    std::vector<Object> parsed;
+    std::vector<Object> compiled;
+    for (const auto& m : EXPRESSIONS) {
+        parsed.emplace_back(parseDataBinding(*context, m));
+        compiled.emplace_back(datagrammar::ByteCode::compile(parsed.back()));
+    }
+
+    volatile size_t sink = 0;
+    double parseTotal = 0, evalTotal = 0, byteCodeTotal = 0;
+
+    for (size_t i = 0 ; i < EXPRESSIONS.size() ; i++) {
+        const auto& expression = EXPRESSIONS[i];
+        const auto& node = parsed[i];
+        const auto& byteCode = compiled[i];
+
+        auto parseTime = nanosPerItem(repeat / 10 + 1, 1, [&]() {
+            sink = sink + parseDataBinding(*context, expression).isNode();
+        });
+
+        auto evalTime = nanosPerItem(repeat, 1, [&]() {
+            sink = sink + node.eval(*context).isString();
+        });
+
+        auto byteCodeTime = nanosPerItem(repeat, 1, [&]() {
+            sink = sink + byteCode.eval(*context).isString();
+        });
+
+        parseTotal += parseTime;
+        evalTotal += evalTime;
+        byteCodeTotal += byteCodeTime;
+
+        if (verbose)
+            std::cout << expression << std::endl
+                      << "  parse=" << parseTime << "ns eval=" << evalTime << "ns bytecode=" << byteCodeTime
+                      << "ns result=" << node.eval(*context).toDebugString() << std::endl;
+    }
+
+    std::cout << "expressions=" << EXPRESSIONS.size()
+              << " parse=" << parseTotal / EXPRESSIONS.size() << "ns"
+              << " eval=" << evalTotal / EXPRESSIONS.size() << "ns"
+              << " bytecode=" << byteCodeTotal / EXPRESSIONS.size() << "ns" << std::endl;
+
+    // Parse throughput
+    std::vector<std::string> corpus;
+    if (!corpusFile.empty()) {
+        std::ifstream in(corpusFile);
+        std::stringstream buffer;
+        buffer << in.rdbuf();
+        rapidjson::Document corpusDoc;
+        if (corpusDoc.Parse(buffer.str().c_str()).HasParseError()) {
+            std::cout << "Unable to parse " << corpusFile << std::endl;
+            return 1;
+        }
+        extractCorpus(corpusDoc, corpus);
+    }
+    else {
+        corpus = EXPRESSIONS;
+    }
+
+    size_t bytes = 0;
+    for (const auto& m : corpus)
+        bytes += m.size();
+
+    if (bytes > 0) {
+        auto nanosPerByte = nanosPerItem(repeat / 10 + 1, bytes, [&]() {
+            for (const auto& m : corpus)
+                sink = sink + parseDataBinding(*context, m).isNode();
+        });
+
+        std::cout << "corpus=" << corpus.size() << " strings " << bytes << " bytes"
+                  << " parse=" << 1000.0 / nanosPerByte << "MB/s" << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,155 @@
+/**
+ * Copyright 2019 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "apl/apl.h"
+
+using namespace apl;
+
+void
+usage(const std::string& msg="")
+{
+    if (!msg.empty())
+        std::cout << msg << std::endl;
+    std::cout << "Usage: benchInflate [options]" << std::endl
+              << std::endl
+              << "  Inflate a Sequence whose items are instantiated from a single layout and report" << std::endl
+              << "  the time spent per item." << std::endl
+              << std::endl
+              << "Options: " << std::endl
+              << "  -h | --help               Print this help" << std::endl
+              << "  -n | --items COUNT        Number of data items in the sequence (defaults to 1000)" << std::endl
+              << "  -r | --repeat COUNT       Number of times the document is inflated (defaults to 10)" << std::endl;
+    exit(1);
+}
+
+static const char *DOCUMENT =
+    "{"
+    "  \"type\": \"APL\","
+    "  \"version\": \"1.1\","
+    "  \"layouts\": {"
+    "    \"ListItem\": {"
+    "      \"parameters\": [ \"title\", \"subtitle\" ],"
+    "      \"item\": {"
+    "        \"type\": \"TouchWrapper\","
+    "        \"onPress\": { \"type\": \"SetValue\", \"componentId\": \"header\", \"property\": \"text\", \"value\": \"${title}\" },"
+    "        \"item\": {"
+    "          \"type\": \"Container\","
+    "          \"direction\": \"row\","
+    "          \"paddingLeft\": 10,"
+    "          \"items\": ["
+    "            {"
+    "              \"type\": \"Frame\","
+    "              \"width\": 40,"
+    "              \"height\": 40,"
+    "              \"borderRadius\": 20,"
+    "              \"backgroundColor\": \"${index % 2 ? 'red' : 'blue'}\""
+    "            },"
+    "            {"
+    "              \"type\": \"Container\","
+    "              \"grow\": 1,"
+    "              \"items\": ["
+    "                { \"type\": \"Text\", \"text\": \"${ordinal}. ${title}\", \"fontSize\": 24, \"maxLines\": 1 },"
+    "                { \"type\": \"Text\", \"text\": \"${subtitle}\", \"fontSize\": 16, \"color\": \"gray\" }"
+    "              ]"
+    "            }"
+    "          ]"
+    "        }"
+    "      }"
+    "    }"
+    "  },"
+    "  \"mainTemplate\": {"
+    "    \"parameters\": [ \"payload\" ],"
+    "    \"item\": {"
+    "      \"type\": \"Sequence\","
+    "      \"width\": \"100%\","
+    "      \"height\": \"100%\","
+    "      \"numbered\": true,"
+    "      \"data\": \"${payload}\","
+    "      \"items\": {"
+    "        \"type\": \"ListItem\","
+    "        \"title\": \"${data.title}\","
+    "        \"subtitle\": \"${data.subtitle}\""
+    "      }"
+    "    }"
+    "  }"
+    "}";
+
+int
+main(int argc, char *argv[]) {
+    unsigned long repeat = 10;
+    size_t count = 1000;
+
+    std::vector<std::string> args(argv + 1, argv + argc);
+    for (auto iter = args.begin(); iter != args.end();) {
+        if (*iter == "-h" || *iter == "--help")
+            usage("");
+
+        if (*iter == "-n" || *iter == "--items") {
+            iter = args.erase(iter);
+            if (iter == args.end())
+                usage("item count expects a value");
+            count = std::stoul(*iter);
+            iter = args.erase(iter);
+        } else if (*iter == "-r" || *iter == "--repeat") {
+            iter = args.erase(iter);
+            if (iter == args.end())
+                usage("repeat count expects a value");
+            repeat = std::stoul(*iter);
+            iter = args.erase(iter);
+        } else {
+            usage("Unknown argument '" + *iter + "'");
+        }
+    }
+
+    if (count == 0 || repeat == 0)
+        usage("items and repeat must be positive");
+
+    std::string payload = "[";
+    for (size_t i = 0 ; i < count ; i++)
+        payload += std::string(i ? "," : "") + "{\"title\": \"Item " + std::to_string(i) +
+                   "\", \"subtitle\": \"Subtitle for item " + std::to_string(i) + "\"}";
+    payload += "]";
+
+    Metrics metrics = Metrics().size(1024, 800);
+    size_t children = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned long i = 0 ; i < repeat ; i++) {
+        auto content = Content::create(DOCUMENT);
+        content->addData("payload", payload);
+        if (!content->isReady()) {
+            std::cout << "Unable to load the document" << std::endl;
+            return 1;
+        }
+
+        auto root = RootContext::create(metrics, content);
+        if (!root) {
+            std::cout << "Unable to inflate the document" << std::endl;
+            return 1;
+        }
+        children = root->topComponent()->getChildCount();
+    }
+    auto elapsed = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start);
+
+    std::cout << "items=" << children
+              << " total=" << elapsed.count() / 1000 << "ms"
+              << " perItem=" << elapsed.count() / (repeat * count) << "us" << std::endl;
+    return 0;
+}
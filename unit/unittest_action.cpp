@@ -13,6 +13,7 @@
  * permissions and limitations under the License.
  */
 
+#include <array>
 #include <iostream>
 #include <sstream>
 #include <queue>
@@ -575,4 +576,105 @@ TEST_F(ActionTest, TerminateAndResolve)
 
     ASSERT_EQ(1, terminate);
     ASSERT_EQ(0, resolve);
-}
\ No newline at end of file
+}
+TEST_F(ActionTest, MultipleTerminateCallbacks)
+{
+    std::vector<int> order;
+    auto p = Action::make(loop, [](ActionRef action) {});
+
+    for (int i = 0 ; i < 3 ; i++)
+        p->addTerminateCallback([&order, i](const TimersPtr&) { order.push_back(i); });
+
+    p->terminate();
+    ASSERT_EQ(std::vector<int>({0, 1, 2}), order);
+}
+
+TEST_F(ActionTest, PooledActionsReuseMemory)
+{
+    auto p = Action::make(loop, [](ActionRef action) {});
+    auto address = p.get();
+    p = nullptr;
+
+    // The next action of the same type takes the block that was just released
+    auto q = Action::make(loop, [](ActionRef action) {});
+    ASSERT_EQ(address, q.get());
+}
+
+TEST_F(ActionTest, SmallFunction)
+{
+    int calls = 0;
+    std::shared_ptr<int> shared = std::make_shared<int>(3);
+    std::weak_ptr<int> weak = shared;
+
+    // A weak pointer capture fits inline and behaves like std::function
+    ThenFunc f = [&calls, weak](const ActionPtr&) { calls += *weak.lock(); };
+    ASSERT_TRUE(f);
+    f(nullptr);
+    ASSERT_EQ(3, calls);
+
+    auto g = f;
+    g(nullptr);
+    ASSERT_EQ(6, calls);
+
+    auto h = std::move(f);
+    ASSERT_FALSE(f);
+    h(nullptr);
+    ASSERT_EQ(9, calls);
+
+    // Captures larger than the inline storage are kept on the heap
+    std::array<double, 16> big;
+    big.fill(1);
+    ThenFunc large = [&calls, big](const ActionPtr&) { calls += big.size(); };
+    auto largeCopy = large;
+    large = nullptr;
+    ASSERT_FALSE(large);
+    largeCopy(nullptr);
+    ASSERT_EQ(25, calls);
+
+    // An empty std::function makes an empty callback
+    std::function<void(const ActionPtr&)> empty;
+    ThenFunc fromEmpty = empty;
+    ASSERT_FALSE(fromEmpty);
+    ASSERT_TRUE(fromEmpty == nullptr);
+}
+
+namespace {
+struct Linked : public IntrusiveListHook<Linked> {
+    Linked(int value, int& destroyed) : value(value), destroyed(destroyed) {}
+    ~Linked() { destroyed++; }
+    int value;
+    int& destroyed;
+};
+}
+
+TEST_F(ActionTest, IntrusiveList)
+{
+    int destroyed = 0;
+    IntrusiveList<Linked> list;
+
+    auto a = std::make_shared<Linked>(1, destroyed);
+    auto b = std::make_shared<Linked>(2, destroyed);
+    auto c = std::make_shared<Linked>(3, destroyed);
+    ASSERT_TRUE(list.push_back(a));
+    ASSERT_TRUE(list.push_back(b));
+    ASSERT_TRUE(list.push_back(c));
+    ASSERT_FALSE(list.push_back(b));
+    ASSERT_EQ(3, list.size());
+
+    // The list keeps its elements alive
+    auto raw = b.get();
+    a = nullptr;
+    b = nullptr;
+    ASSERT_EQ(0, destroyed);
+
+    ASSERT_TRUE(list.remove(raw));
+    ASSERT_EQ(1, destroyed);
+    ASSERT_TRUE(list.remove(c.get()));
+    ASSERT_FALSE(list.remove(c.get()));
+    ASSERT_FALSE(c->isLinked());
+    ASSERT_EQ(1, list.size());
+
+    list.clear();
+    ASSERT_TRUE(list.empty());
+    ASSERT_EQ(2, destroyed);
+}
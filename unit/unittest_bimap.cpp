@@ -0,0 +1,95 @@
+/**
+ * Copyright 2019 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+
+#include "apl/utils/bimap.h"
+
+using namespace apl;
+
+class BimapTest : public ::testing::Test {};
+
+TEST_F(BimapTest, Canonical) {
+    Bimap<int, std::string> test = {
+        { 10, "dog" },
+        { 20, "dog" },
+        { 20, "cat" }
+    };
+
+    ASSERT_EQ(10, test.at("dog"));
+    ASSERT_EQ(20, test.at("cat"));
+    ASSERT_EQ("dog", test.at(10));
+    ASSERT_EQ("dog", test.at(20));
+
+    ASSERT_TRUE(test.has(10));
+    ASSERT_FALSE(test.has(15));
+    ASSERT_FALSE(test.has(-1));
+    ASSERT_FALSE(test.has(100));
+    ASSERT_TRUE(test.has("cat"));
+    ASSERT_FALSE(test.has("fish"));
+
+    ASSERT_EQ("none", test.get(15, "none"));
+    ASSERT_EQ(-1, test.get("fish", -1));
+    ASSERT_THROW(test.at(15), std::out_of_range);
+}
+
+TEST_F(BimapTest, Sparse) {
+    Bimap<int, std::string> test = {
+        { -100000, "low" },
+        { 0, "zero" },
+        { 100000, "high" }
+    };
+
+    ASSERT_EQ("low", test.at(-100000));
+    ASSERT_EQ("high", test.at(100000));
+    ASSERT_EQ("zero", test.get(0, ""));
+    ASSERT_FALSE(test.has(1));
+    ASSERT_EQ(100000, test.at("high"));
+}
+
+TEST_F(BimapTest, AppendAndCopy) {
+    Bimap<int, std::string> test = {
+        { 0, "a" },
+        { 1, "b" }
+    };
+
+    ASSERT_EQ(2, test.append("c"));
+    ASSERT_EQ(1, test.append("b"));
+    ASSERT_EQ("c", test.at(2));
+    ASSERT_EQ(3, test.size());
+
+    auto copy = test;
+    test.append("d");
+    ASSERT_EQ("c", copy.at(2));
+    ASSERT_FALSE(copy.has(3));
+    ASSERT_EQ("d", test.at(3));
+
+    // Iteration is ordered by the first type
+    int expected = 0;
+    for (const auto& m : test)
+        ASSERT_EQ(expected++, m.first);
+}
+
+TEST_F(BimapTest, NonIntegral) {
+    Bimap<std::string, int> test = {
+        { "one", 1 },
+        { "two", 2 }
+    };
+
+    ASSERT_EQ(2, test.at("two"));
+    ASSERT_EQ("one", test.at(1));
+    ASSERT_FALSE(test.has(std::string("three")));
+    ASSERT_EQ(-1, test.get(std::string("three"), -1));
+}
@@ -487,4 +487,56 @@ TEST_F(BoundsTest, AbsolutePositioning)
     ASSERT_EQ(Rect(810, 340, 50, 50), text2->getGlobalBounds());
 
     component->release();
-}
\ No newline at end of file
+}
+
+static const char *MOVING_PARENT =
+    "{"
+    "  \"type\": \"APL\","
+    "  \"version\": \"1.1\","
+    "  \"mainTemplate\": {"
+    "    \"item\": {"
+    "      \"type\": \"Container\","
+    "      \"width\": \"100vw\","
+    "      \"height\": \"100vh\","
+    "      \"items\": ["
+    "        {"
+    "          \"type\": \"Frame\","
+    "          \"id\": \"spacer\","
+    "          \"width\": 100,"
+    "          \"height\": 100"
+    "        },"
+    "        {"
+    "          \"type\": \"Container\","
+    "          \"paddingLeft\": 20,"
+    "          \"items\": {"
+    "            \"type\": \"Frame\","
+    "            \"id\": \"inner\","
+    "            \"width\": 50,"
+    "            \"height\": 50"
+    "          }"
+    "        }"
+    "      ]"
+    "    }"
+    "  }"
+    "}";
+
+/**
+ * Global bounds are cached.  Moving an ancestor must update the cached bounds of its descendants
+ * even when their own bounds within the parent have not changed.
+ */
+TEST_F(BoundsTest, AncestorMoves)
+{
+    loadDocument(MOVING_PARENT);
+
+    auto inner = root->context().findComponentById("inner");
+    ASSERT_TRUE(inner);
+    ASSERT_EQ(Rect(20, 0, 50, 50), inner->getCalculated(kPropertyBounds).getRect());
+    ASSERT_EQ(Rect(20, 100, 50, 50), inner->getGlobalBounds());
+
+    auto spacer = root->context().findComponentById("spacer");
+    ASSERT_TRUE(spacer->remove());
+    root->clearPending();
+
+    ASSERT_EQ(Rect(20, 0, 50, 50), inner->getCalculated(kPropertyBounds).getRect());
+    ASSERT_EQ(Rect(20, 0, 50, 50), inner->getGlobalBounds());
+}
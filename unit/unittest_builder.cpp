@@ -22,6 +22,7 @@
 #include "apl/engine/evaluate.h"
 #include "apl/content/metrics.h"
 #include "apl/component/component.h"
+#include "apl/component/componentprototype.h"
 #include "apl/engine/builder.h"
 #include "apl/primitives/transform.h"
 #include "apl/utils/streamer.h"
@@ -133,6 +134,11 @@ TEST_F(BuilderTest, SimpleImage)
     ASSERT_EQ(component, context->findComponentById(component->getUniqueId()));
     ASSERT_EQ(component, context->findComponentById("abc"));
     ASSERT_FALSE(context->findComponentById("foo"));
+    ASSERT_EQ(":" + std::to_string(component->getUniqueIdNumber()), component->getUniqueId());
+    ASSERT_FALSE(context->findComponentById(":" + std::to_string(component->getUniqueIdNumber() + 1)));
+    ASSERT_FALSE(context->findComponentById(":0" + std::to_string(component->getUniqueIdNumber())));
+    ASSERT_FALSE(context->findComponentById(component->getUniqueId() + "x"));
+    ASSERT_FALSE(context->findComponentById(":"));
 
     // Standard properties
     ASSERT_EQ(Object(""), component->getCalculated(kPropertyAccessibilityLabel));
@@ -2577,4 +2583,130 @@ TEST_F(BuilderTest, ConfigTextFuzzyTheme)
     config.defaultFontColor("fuzzy", 0x44332211);
     loadDocument(CONFIG_TEXT_FUZZY_THEME);
     ASSERT_TRUE(IsEqual(Color(0x44332211), component->getCalculated(kPropertyColor)));
-}
\ No newline at end of file
+}
+
+static const char *SHARED_DEFAULTS = "{"
+    "  \"type\": \"APL\","
+    "  \"version\": \"1.1\","
+    "  \"mainTemplate\": {"
+    "    \"item\": {"
+    "      \"type\": \"Container\","
+    "      \"items\": ["
+    "        { \"type\": \"Frame\", \"id\": \"plain\" },"
+    "        { \"type\": \"Frame\", \"id\": \"custom\", \"opacity\": 0.5, \"borderWidth\": 2 }"
+    "      ]"
+    "    }"
+    "  }"
+    "}";
+
+TEST_F(BuilderTest, SharedDefaults)
+{
+    loadDocument(SHARED_DEFAULTS);
+    auto plain = std::static_pointer_cast<CoreComponent>(context->findComponentById("plain"));
+    auto custom = std::static_pointer_cast<CoreComponent>(context->findComponentById("custom"));
+    ASSERT_TRUE(plain);
+    ASSERT_TRUE(custom);
+
+    // Both frames see the full set of properties, but most of them come from the shared defaults
+    auto& plainMap = plain->getCalculated();
+    auto& customMap = custom->getCalculated();
+    ASSERT_EQ(plainMap.size(), customMap.size());
+    ASSERT_LT(plainMap.localSize(), plainMap.size() / 2);
+    ASSERT_EQ(plainMap.localSize() + 2, customMap.localSize());
+
+    ASSERT_TRUE(IsEqual(1.0, plain->getCalculated(kPropertyOpacity)));
+    ASSERT_TRUE(IsEqual(0.5, custom->getCalculated(kPropertyOpacity)));
+    ASSERT_TRUE(IsEqual(Dimension(0), plain->getCalculated(kPropertyBorderWidth)));
+    ASSERT_TRUE(IsEqual(Dimension(2), custom->getCalculated(kPropertyBorderWidth)));
+
+    // Iteration visits every property exactly once, in key order
+    size_t count = 0;
+    int lastKey = -1;
+    for (const auto& m : customMap) {
+        ASSERT_LT(lastKey, static_cast<int>(m.first));
+        ASSERT_EQ(m.second, custom->getCalculated(m.first));
+        lastKey = m.first;
+        count++;
+    }
+    ASSERT_EQ(customMap.size(), count);
+
+    // Setting a value back to its default drops the local copy
+    custom->setProperty(kPropertyOpacity, 1.0);
+    ASSERT_TRUE(IsEqual(1.0, custom->getCalculated(kPropertyOpacity)));
+    ASSERT_EQ(plainMap.localSize() + 1, customMap.localSize());
+    ASSERT_TRUE(CheckDirty(custom, kPropertyOpacity));
+}
+
+static const char *PROTOTYPE_LAYOUT =
+    "{"
+    "  \"type\": \"APL\","
+    "  \"version\": \"1.1\","
+    "  \"resources\": ["
+    "    { \"dimensions\": { \"gap\": 7 } }"
+    "  ],"
+    "  \"layouts\": {"
+    "    \"Row\": {"
+    "      \"parameters\": [ \"label\" ],"
+    "      \"item\": {"
+    "        \"type\": \"Text\","
+    "        \"text\": \"${label}\","
+    "        \"width\": 100,"
+    "        \"paddingLeft\": \"@gap\","
+    "        \"color\": \"red\""
+    "      }"
+    "    }"
+    "  },"
+    "  \"mainTemplate\": {"
+    "    \"items\": {"
+    "      \"type\": \"Sequence\","
+    "      \"data\": [ \"a\", \"b\", \"c\" ],"
+    "      \"item\": {"
+    "        \"type\": \"Row\","
+    "        \"label\": \"${data}\","
+    "        \"width\": \"${index * 10 + 50}\""
+    "      }"
+    "    }"
+    "  }"
+    "}";
+
+TEST_F(BuilderTest, ComponentPrototypes)
+{
+    loadDocument(PROTOTYPE_LAYOUT);
+    ASSERT_EQ(3, component->getChildCount());
+
+    for (int i = 0 ; i < 3 ; i++) {
+        auto child = component->getChildAt(i);
+        ASSERT_EQ(std::string(1, 'a' + i), child->getCalculated(kPropertyText).asString());
+        ASSERT_EQ(Object(Color(Color::RED)), child->getCalculated(kPropertyColor));
+        ASSERT_TRUE(IsEqual(Dimension(7), child->getCalculated(kPropertyPaddingLeft)));
+
+        // The width of the layout instance takes precedence over the width inside the layout
+        ASSERT_TRUE(IsEqual(Dimension(50 + 10 * i), child->getCalculated(kPropertyWidth)));
+    }
+
+    // Every Text shares the prototype of the layout item
+    rapidjson::Document doc;
+    doc.Parse(R"({"type": "Text", "text": "${label}", "color": "red", "paddingLeft": "@gap", "label": 1})");
+    auto& prototype = context->getComponentPrototype(doc);
+    ASSERT_EQ(&prototype, &context->getComponentPrototype(doc));
+
+    // Names that are not component properties are dropped and the rest are sorted by key
+    const auto& entries = prototype.entries();
+    ASSERT_EQ(3, entries.size());
+    ASSERT_TRUE(std::is_sorted(entries.begin(), entries.end(),
+                               [](const ComponentPrototype::Entry& a, const ComponentPrototype::Entry& b) {
+                                   return a.key < b.key;
+                               }));
+    for (const auto& entry : entries) {
+        if (entry.key == kPropertyColor)
+            ASSERT_FALSE(entry.bound);
+        else
+            ASSERT_TRUE(entry.bound);   // The data-bound text and the resource reference
+    }
+
+    // A different template at the same address is recompiled
+    ASSERT_TRUE(prototype.matches(doc));
+    doc.Parse(R"({"type": "Frame", "width": 10})");
+    ASSERT_FALSE(prototype.matches(doc));
+    ASSERT_EQ(1, context->getComponentPrototype(doc).entries().size());
+}
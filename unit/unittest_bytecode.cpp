@@ -0,0 +1,113 @@
+/**
+ * Copyright 2019 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "testeventloop.h"
+
+#include "apl/content/metrics.h"
+#include "apl/content/rootconfig.h"
+#include "apl/datagrammar/bytecode.h"
+#include "apl/engine/context.h"
+#include "apl/engine/evaluate.h"
+#include "apl/primitives/dimension.h"
+#include "apl/utils/session.h"
+
+using namespace apl;
+
+class ByteCodeTest : public ::testing::Test {
+protected:
+    void SetUp() override
+    {
+        c = Context::create(Metrics().size(1024, 800), makeDefaultSession());
+        c->putUserWriteable("a", 0);
+        c->putUserWriteable("b", "value");
+        c->putUserWriteable("n", Object::NULL_OBJECT());
+        c->putUserWriteable("x", Dimension(10));
+        c->putUserWriteable("p", Dimension(DimensionType::Relative, 20));
+        c->putUserWriteable("i", 3);
+
+        auto map = std::make_shared<ObjectMap>();
+        map->emplace("title", "Hello");
+        map->emplace("list", ObjectArray{1, 2, 3});
+        c->putUserWriteable("data", Object(map));
+    }
+
+    ContextPtr c;
+};
+
+static const std::vector<std::string> EXPRESSIONS = {
+    "${a}", "${-i}", "${+x}", "${!a}", "${!!b}",
+    "${i * 2}", "${2 * i}", "${i / 0}", "${i % 2}", "${x + 5}", "${p - 5}", "${i + b}",
+    "${i < 4}", "${4 > i}", "${x <= 10}", "${p >= 30}", "${b == 'value'}", "${n != null}",
+    "${a && b}", "${b && a}", "${a || b}", "${b || a}", "${n ?? b}", "${a ?? b}",
+    "${i > 2 ? 'big' : 'small'}", "${i > 5 ? 'big' : i > 1 ? 'medium' : 'small'}",
+    "${data.title}", "${data.list[1]}", "${data.list[-1]}", "${data.list.length}", "${data['title']}",
+    "${data.missing.field}", "${a.b}",
+    "Item ${i + 1}: ${data.title} ${''}${b}",
+    "${'nested ${i} ${b}'} and ${data.title}",
+    "${Math.max(a, i, 2)}", "${Math.min(i, 1)}", "${String.toUpperCase(data.title)}",
+    "${Math.max(a, i) + Math.min(i, 1) * (i - (a + (i * (a - (i + (a * (i - (a + 1))))))))}",
+    "${a ? Math.max(1, 2) : String.slice(b, 1, i)}",
+    "${b(1)}",
+};
+
+TEST_F(ByteCodeTest, MatchesTreeEvaluation)
+{
+    for (const auto& expression : EXPRESSIONS) {
+        auto tree = parseDataBinding(*c, expression);
+        ASSERT_TRUE(tree.isNode()) << expression;
+
+        auto compiled = datagrammar::ByteCode::compile(tree);
+        ASSERT_TRUE(compiled.isNode()) << expression;
+
+        auto expected = tree.eval(*c);
+        auto actual = compiled.eval(*c);
+        ASSERT_EQ(expected.getType(), actual.getType()) << expression;
+        ASSERT_EQ(expected.toDebugString(), actual.toDebugString()) << expression;
+    }
+}
+
+TEST_F(ByteCodeTest, Symbols)
+{
+    auto compiled = datagrammar::ByteCode::compile(parseDataBinding(*c, "${a + data.title}"));
+
+    std::set<std::string> symbols;
+    compiled.symbols(symbols);
+    ASSERT_EQ(2, symbols.size());
+    ASSERT_EQ(1, symbols.count("a"));
+    ASSERT_EQ(1, symbols.count("data"));
+}
+
+TEST_F(ByteCodeTest, Constants)
+{
+    // Constant expressions are folded by the parser and are not compiled
+    ASSERT_TRUE(IsEqual(4, datagrammar::ByteCode::compile(parseDataBinding(*c, "${1+3}"))));
+    ASSERT_TRUE(IsEqual("abc", datagrammar::ByteCode::compile(Object("abc"))));
+}
+
+TEST_F(ByteCodeTest, RootConfigOption)
+{
+    auto config = RootConfig().compileExpressions(true);
+    auto context = Context::create(Metrics(), config);
+    context->putUserWriteable("i", 3);
+
+    auto parsed = parseDataBinding(*context, "${i * 2}");
+    ASSERT_TRUE(parsed.isNode());
+    ASSERT_EQ("bytecode", parsed.getNode().getName());
+    ASSERT_TRUE(IsEqual(6, parsed.eval(*context)));
+
+    context->userUpdateAndRecalculate("i", 4, false);
+    ASSERT_TRUE(IsEqual(8, parsed.eval(*context)));
+}
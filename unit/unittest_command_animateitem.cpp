@@ -679,6 +679,78 @@ TEST_F(AnimateItemTest, OpacityAndTransformTerminate)
 }
 
 
+// The view host runs the animation and resolves the event when done
+TEST_F(AnimateItemTest, OffloadOpacityAndTransform)
+{
+    config.offloadAnimations(true);
+    loadDocument(ANIMATE_OPACITY_AND_TRANSFORM);
+    auto frame = root->context().findComponentById("box");
+    auto goButton = root->context().findComponentById("go");
+    ASSERT_TRUE(frame);
+    ASSERT_TRUE(goButton);
+
+    goButton->update(kUpdatePressed);
+    root->clearPending();
+
+    // Starting values are assigned, but nothing is scheduled in the core
+    ASSERT_EQ(Object(0), frame->getCalculated(kPropertyOpacity));
+    ASSERT_EQ(Transform2D::translateX(metrics.getWidth()), frame->getCalculated(kPropertyTransform).getTransform2D());
+    ASSERT_TRUE(CheckDirty(frame, kPropertyOpacity, kPropertyTransform));
+    ASSERT_EQ(0, loop->size());
+
+    ASSERT_TRUE(root->hasEvent());
+    auto event = root->popEvent();
+    ASSERT_EQ(kEventTypeAnimateItem, event.getType());
+    ASSERT_EQ(frame, event.getComponent());
+    ASSERT_EQ(Object(1000), event.getValue(kEventPropertyDuration));
+    ASSERT_EQ(Object(3), event.getValue(kEventPropertyRepeatCount));
+    ASSERT_EQ(Object(kCommandRepeatModeRestart), event.getValue(kEventPropertyRepeatMode));
+    ASSERT_TRUE(event.getValue(kEventPropertyEasing).isEasing());
+
+    auto values = event.getValue(kEventPropertyValue);
+    ASSERT_EQ(2, values.size());
+    ASSERT_EQ(Object("opacity"), values.at(0).get("property"));
+    ASSERT_EQ(Object(0), values.at(0).get("from"));
+    ASSERT_EQ(Object(1), values.at(0).get("to"));
+    ASSERT_EQ(Object("transform"), values.at(1).get("property"));
+    ASSERT_TRUE(values.at(1).get("value").isTransform());
+
+    // Time passing does not touch the component
+    loop->advanceToTime(loop->currentTime() + 5000);
+    ASSERT_EQ(Object(0), frame->getCalculated(kPropertyOpacity));
+    ASSERT_TRUE(CheckDirty(frame));
+
+    // Resolving the event reconciles the final state
+    event.getActionRef().resolve();
+    loop->advanceToEnd();
+    ASSERT_EQ(Object(1), frame->getCalculated(kPropertyOpacity));
+    ASSERT_EQ(Object::IDENTITY_2D(), frame->getCalculated(kPropertyTransform));
+    ASSERT_TRUE(CheckDirty(frame, kPropertyOpacity, kPropertyTransform));
+    ASSERT_FALSE(root->hasEvent());
+}
+
+TEST_F(AnimateItemTest, OffloadTerminate)
+{
+    config.offloadAnimations(true);
+    loadDocument(ANIMATE_OPACITY_AND_TRANSFORM);
+    auto frame = root->context().findComponentById("box");
+    auto goButton = root->context().findComponentById("go");
+
+    goButton->update(kUpdatePressed);
+    root->clearPending();
+
+    ASSERT_TRUE(root->hasEvent());
+    auto event = root->popEvent();
+    ASSERT_EQ(kEventTypeAnimateItem, event.getType());
+    root->clearDirty();
+
+    root->cancelExecution();
+    ASSERT_TRUE(event.getActionRef().isTerminated());
+    ASSERT_EQ(Object(1), frame->getCalculated(kPropertyOpacity));
+    ASSERT_EQ(Object::IDENTITY_2D(), frame->getCalculated(kPropertyTransform));
+    ASSERT_TRUE(CheckDirty(frame, kPropertyOpacity, kPropertyTransform));
+}
+
 static const char * OPACITY_AND_RICH_TRANSFORM =
     "{"
     "  \"type\": \"APL\","
@@ -1060,3 +1132,104 @@ TEST_F(AnimateItemTest, ScrollTest)
     ASSERT_EQ(0, loop->size());
     ASSERT_TRUE(CheckDirty(frame));
 }
+
+static const char *STAGGERED =
+    "{"
+    "  \"type\": \"APL\","
+    "  \"version\": \"1.1\","
+    "  \"mainTemplate\": {"
+    "    \"item\": {"
+    "      \"type\": \"Container\","
+    "      \"data\": [0, 1, 2, 3, 4, 5, 6, 7, 8, 9],"
+    "      \"items\": {"
+    "        \"type\": \"Frame\","
+    "        \"id\": \"box${data}\","
+    "        \"width\": 10,"
+    "        \"height\": 10"
+    "      }"
+    "    }"
+    "  }"
+    "}";
+
+// Staggered animations with different easing curves run together in the animation batch
+TEST_F(AnimateItemTest, Staggered)
+{
+    loadDocument(STAGGERED);
+
+    std::string commands = "[{\"type\": \"Parallel\", \"commands\": [";
+    for (int i = 0 ; i < 10 ; i++) {
+        commands += std::string(i ? "," : "") +
+                    "{\"type\": \"AnimateItem\", \"componentId\": \"box" + std::to_string(i) + "\"," +
+                    " \"delay\": " + std::to_string(i * 50) + ", \"duration\": 500," +
+                    " \"easing\": \"" + (i % 2 ? "ease-in" : "linear") + "\"," +
+                    " \"value\": [{\"property\": \"opacity\", \"from\": 1, \"to\": 0}," +
+                    " {\"property\": \"transform\", \"from\": {\"translateX\": 0}, \"to\": {\"translateX\": 100}}]}";
+    }
+    commands += "]}]";
+
+    rapidjson::Document doc;
+    doc.Parse(commands.c_str());
+    auto startTime = loop->currentTime();
+    root->executeCommands(doc, false);
+
+    auto linear = Easing::parse(session, "linear");
+    auto easeIn = Easing::parse(session, "ease-in");
+
+    for (int t = 25 ; t <= 1000 ; t += 25) {
+        loop->advanceToTime(startTime + t);
+        ASSERT_EQ(0, loop->animatorCount());
+
+        for (int i = 0 ; i < 10 ; i++) {
+            auto box = root->context().findComponentById("box" + std::to_string(i));
+            float alpha = std::max(0.0f, std::min(1.0f, (t - i * 50) / 500.0f));
+            float eased = i % 2 ? easeIn(alpha) : linear(alpha);
+            ASSERT_NEAR(1 - eased, box->getCalculated(kPropertyOpacity).asNumber(), 0.0001)
+                << "box " << i << " time " << t;
+
+            if (t > i * 50) {
+                auto transform = box->getCalculated(kPropertyTransform).getTransform2D();
+                ASSERT_NEAR(100 * eased, transform.get()[4], 0.001) << "box " << i << " time " << t;
+            }
+        }
+    }
+
+    ASSERT_EQ(0, loop->size());
+}
+
+// Animations that finish are removed from the batch while the others keep running
+TEST_F(AnimateItemTest, StaggeredDurations)
+{
+    loadDocument(STAGGERED);
+
+    std::string commands = "[{\"type\": \"Parallel\", \"commands\": [";
+    for (int i = 0 ; i < 10 ; i++) {
+        commands += std::string(i ? "," : "") +
+                    "{\"type\": \"AnimateItem\", \"componentId\": \"box" + std::to_string(i) + "\"," +
+                    " \"duration\": " + std::to_string((i + 1) * 100) + "," +
+                    " \"value\": {\"property\": \"opacity\", \"from\": 0, \"to\": 1}}";
+    }
+    commands += "]}]";
+
+    rapidjson::Document doc;
+    doc.Parse(commands.c_str());
+    auto startTime = loop->currentTime();
+    root->executeCommands(doc, false);
+
+    for (int t = 50 ; t <= 500 ; t += 50) {
+        loop->advanceToTime(startTime + t);
+        for (int i = 0 ; i < 10 ; i++) {
+            auto box = root->context().findComponentById("box" + std::to_string(i));
+            ASSERT_NEAR(std::min(1.0, t / ((i + 1) * 100.0)), box->getCalculated(kPropertyOpacity).asNumber(), 0.0001)
+                << "box " << i << " time " << t;
+        }
+    }
+
+    // Cancelling the command moves the remaining animations to their end state
+    root->cancelExecution();
+    for (int i = 0 ; i < 10 ; i++) {
+        auto box = root->context().findComponentById("box" + std::to_string(i));
+        ASSERT_EQ(Object(1), box->getCalculated(kPropertyOpacity)) << "box " << i;
+    }
+
+    ASSERT_EQ(0, loop->size());
+}
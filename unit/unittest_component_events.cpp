@@ -221,6 +221,90 @@ TEST_F(ComponentEventsTest, ComponentScrolled)
     loop->advanceToEnd();
     ASSERT_EQ(1, root->getDirty().size());
     ASSERT_EQ("Two", text->getCalculated(kPropertyText).asString());
+
+    // The handler never reads "event", so it runs in the component context
+    auto core = std::static_pointer_cast<CoreComponent>(component);
+    ASSERT_EQ(component->getContext(), core->createHandlerContext(kPropertyOnScroll, "Scroll", 10));
+}
+
+static const char *SCROLL_HANDLER_EVENT_USE =
+        "{"
+        "  \"type\": \"APL\","
+        "  \"version\": \"1.0\","
+        "  \"commands\": {"
+        "    \"MyMacro\": {"
+        "      \"commands\": { \"type\": \"Idle\" }"
+        "    }"
+        "  },"
+        "  \"mainTemplate\": {"
+        "    \"items\": {"
+        "      \"type\": \"Container\","
+        "      \"items\": ["
+        "        {"
+        "          \"type\": \"ScrollView\","
+        "          \"id\": \"reads\","
+        "          \"onScroll\": {"
+        "            \"type\": \"Sequential\","
+        "            \"commands\": {"
+        "              \"type\": \"SetValue\","
+        "              \"componentId\": \"textComp\","
+        "              \"property\": \"text\","
+        "              \"value\": \"${event.source.value}\""
+        "            }"
+        "          }"
+        "        },"
+        "        {"
+        "          \"type\": \"ScrollView\","
+        "          \"id\": \"sends\","
+        "          \"onScroll\": { \"type\": \"SendEvent\" }"
+        "        },"
+        "        {"
+        "          \"type\": \"ScrollView\","
+        "          \"id\": \"macro\","
+        "          \"onScroll\": { \"type\": \"MyMacro\" }"
+        "        },"
+        "        {"
+        "          \"type\": \"ScrollView\","
+        "          \"id\": \"ignores\","
+        "          \"bind\": { \"name\": \"eventual\", \"value\": 3 },"
+        "          \"onScroll\": { \"type\": \"SetValue\", \"property\": \"opacity\", \"value\": \"${eventual / 4}\" }"
+        "        },"
+        "        {"
+        "          \"type\": \"Text\","
+        "          \"id\": \"textComp\","
+        "          \"text\": \"One\""
+        "        }"
+        "      ]"
+        "    }"
+        "  }"
+        "}";
+
+TEST_F(ComponentEventsTest, ScrollHandlerEventUse)
+{
+    loadDocument(SCROLL_HANDLER_EVENT_USE);
+    ASSERT_TRUE(component);
+
+    // Commands that refer to "event", SendEvent and macros get the event properties
+    for (const auto& id : {"reads", "sends", "macro"}) {
+        auto scroll = std::static_pointer_cast<CoreComponent>(root->context().findComponentById(id));
+        ASSERT_TRUE(scroll);
+        auto handlerContext = scroll->createHandlerContext(kPropertyOnScroll, "Scroll", 0);
+        ASSERT_NE(scroll->getContext(), handlerContext) << id;
+        ASSERT_TRUE(handlerContext->has("event")) << id;
+    }
+
+    // A symbol that only starts with "event" doesn't count
+    auto ignores = std::static_pointer_cast<CoreComponent>(root->context().findComponentById("ignores"));
+    ASSERT_EQ(ignores->getContext(), ignores->createHandlerContext(kPropertyOnScroll, "Scroll", 0));
+    ignores->update(kUpdateScrollPosition, 10);
+    loop->advanceToEnd();
+    ASSERT_EQ(Object(0.75), ignores->getCalculated(kPropertyOpacity));
+
+    // The event properties still reach the commands that read them
+    auto reads = root->context().findComponentById("reads");
+    reads->update(kUpdateScrollPosition, 10);
+    loop->advanceToEnd();
+    ASSERT_EQ("0.1", root->context().findComponentById("textComp")->getCalculated(kPropertyText).asString());
 }
 
 static const char *PAGER_CHANGED =
@@ -54,6 +54,102 @@ TEST_F(CurrentTimeTest, Basic)
     ASSERT_TRUE(IsEqual(1001, root->currentTime()));
 }
 
+// Timers that do not fit in the budget are left for the next call
+TEST_F(CurrentTimeTest, Budget)
+{
+    const apl_time_t START_TIME = 1567685739476;
+    config.localTime(START_TIME);
+
+    loadDocument(TIME);
+    ASSERT_TRUE(component);
+
+    int fired = 0;
+    for (int i = 1 ; i <= 3 ; i++)
+        loop->setTimeout([&fired]() { fired++; }, i * 100);
+
+    // A zero budget runs a single timer
+    ASSERT_TRUE(root->updateTimeWithBudget(1000, 0));
+    ASSERT_EQ(1, fired);
+    ASSERT_EQ(100, root->currentTime());
+    ASSERT_TRUE(IsEqual("100 1567685739576", component->getCalculated(kPropertyText).asString()));
+
+    // Checking for events doesn't run the timers that were put off
+    ASSERT_FALSE(root->hasEvent());
+    ASSERT_EQ(1, fired);
+
+    ASSERT_TRUE(root->updateTimeWithBudget(1000, 0));
+    ASSERT_EQ(2, fired);
+    ASSERT_EQ(200, root->currentTime());
+
+    // The last timer runs and the clock reaches the requested time
+    ASSERT_FALSE(root->updateTimeWithBudget(1000, 0));
+    ASSERT_EQ(3, fired);
+    ASSERT_EQ(1000, root->currentTime());
+    ASSERT_TRUE(IsEqual("1000 1567685740476", component->getCalculated(kPropertyText).asString()));
+
+    // A generous budget runs everything at once
+    for (int i = 1 ; i <= 3 ; i++)
+        loop->setTimeout([&fired]() { fired++; }, i * 100);
+    ASSERT_FALSE(root->updateTimeWithBudget(2000, 1000));
+    ASSERT_EQ(6, fired);
+    ASSERT_EQ(2000, root->currentTime());
+}
+
+TEST_F(CurrentTimeTest, BudgetSameTime)
+{
+    loadDocument(TIME);
+    ASSERT_TRUE(component);
+
+    std::vector<int> fired;
+    for (int i = 1 ; i <= 4 ; i++)
+        loop->setTimeout([&fired, i]() { fired.push_back(i); }, 100);
+    auto cleared = loop->setTimeout([&fired]() { fired.push_back(5); }, 100);
+
+    // The first timer also sets a zero-delay timer, which is part of the same slice of work
+    loop->setTimeout([&]() {
+        fired.push_back(0);
+        loop->setTimeout([&fired]() { fired.push_back(6); }, 0);
+    }, 50);
+
+    ASSERT_TRUE(root->updateTimeWithBudget(1000, 0));
+    ASSERT_EQ(std::vector<int>({0}), fired);
+    ASSERT_EQ(50, root->currentTime());
+
+    // The zero-delay timer has reached its end time, but checking for events doesn't run it
+    ASSERT_FALSE(root->hasEvent());
+    root->clearPending();
+    ASSERT_EQ(1, fired.size());
+    ASSERT_EQ(50, loop->nextTimeout());
+
+    ASSERT_TRUE(root->updateTimeWithBudget(1000, 0));
+    ASSERT_EQ(std::vector<int>({0, 6}), fired);
+
+    ASSERT_TRUE(root->updateTimeWithBudget(1000, 0));
+    ASSERT_EQ(3, fired.size());
+    ASSERT_EQ(100, root->currentTime());
+
+    // Four timers share the end time of the last one.  None run outside the budget.
+    ASSERT_FALSE(root->hasEvent());
+    ASSERT_EQ(3, fired.size());
+    ASSERT_EQ(4, loop->size());
+
+    // A deferred timer can still be cleared
+    ASSERT_TRUE(loop->clearTimeout(cleared));
+    ASSERT_EQ(3, loop->size());
+
+    // Repeating the same time keeps to the budget
+    ASSERT_TRUE(root->updateTimeWithBudget(100, 0));
+    ASSERT_EQ(4, fired.size());
+    ASSERT_EQ(100, root->currentTime());
+
+    ASSERT_TRUE(root->updateTimeWithBudget(100, 0));
+    ASSERT_EQ(5, fired.size());
+
+    ASSERT_FALSE(root->updateTimeWithBudget(100, 0));
+    ASSERT_EQ(std::vector<int>({0, 6, 1, 2, 3, 4}), fired);
+    ASSERT_EQ(0, loop->size());
+}
+
 
 static const char *TIME_YEAR =
     "{"
@@ -577,4 +577,97 @@ TEST_F(DependantTest, Nested)
                                 {"value",       "Fred"}}, true);
     loop->advanceToEnd();
     ASSERT_TRUE(IsEqual("Sam the not so great of Mesopotamia", text->getCalculated(kPropertyText).asString()));
-}
\ No newline at end of file
+}
+
+static const char *DIAMOND =
+    "{"
+    "  \"type\": \"APL\","
+    "  \"version\": \"1.1\","
+    "  \"mainTemplate\": {"
+    "    \"items\": {"
+    "      \"type\": \"Text\","
+    "      \"bind\": ["
+    "        {"
+    "          \"name\": \"a\","
+    "          \"value\": 2"
+    "        },"
+    "        {"
+    "          \"name\": \"b\","
+    "          \"value\": \"${a*2}\""
+    "        }"
+    "      ],"
+    "      \"text\": \"${a} and ${b}\""
+    "    }"
+    "  }"
+    "}";
+
+// The text depends on "a" directly and through "b".  Changing "a" only recalculates the text once.
+TEST_F(DependantTest, Diamond)
+{
+    loadDocument(DIAMOND);
+    ASSERT_TRUE(component);
+    ASSERT_TRUE(IsEqual("2 and 4", component->getCalculated(kPropertyText).asString()));
+
+    const auto& stats = root->getRecalculationStats();
+    ASSERT_EQ(0, stats.total());
+
+    ASSERT_TRUE(component->getContext()->userUpdateAndRecalculate("a", 3, true));
+    ASSERT_TRUE(IsEqual("3 and 6", component->getCalculated(kPropertyText).asString()));
+    ASSERT_TRUE(CheckDirty(component, kPropertyText));
+
+    ASSERT_EQ(2, stats.changed);    // "b" and the text
+    ASSERT_EQ(1, stats.skipped);    // The text, reached a second time through "a"
+    ASSERT_EQ(0, stats.unchanged);
+}
+
+static const char *UNCHANGED_RESULT =
+    "{"
+    "  \"type\": \"APL\","
+    "  \"version\": \"1.1\","
+    "  \"mainTemplate\": {"
+    "    \"items\": {"
+    "      \"type\": \"Text\","
+    "      \"bind\": ["
+    "        {"
+    "          \"name\": \"a\","
+    "          \"value\": 10"
+    "        },"
+    "        {"
+    "          \"name\": \"big\","
+    "          \"value\": \"${a > 5}\""
+    "        }"
+    "      ],"
+    "      \"text\": \"${a > 5 ? 'big' : 'small'}\","
+    "      \"color\": \"${big ? 'red' : 'blue'}\""
+    "    }"
+    "  }"
+    "}";
+
+// A change that doesn't alter the result of an expression stops at that expression
+TEST_F(DependantTest, UnchangedResult)
+{
+    loadDocument(UNCHANGED_RESULT);
+    ASSERT_TRUE(component);
+    ASSERT_TRUE(IsEqual("big", component->getCalculated(kPropertyText).asString()));
+    ASSERT_TRUE(IsEqual(Color(Color::RED), component->getCalculated(kPropertyColor)));
+
+    const auto& stats = root->getRecalculationStats();
+
+    // The expressions remember their values from inflation, so the first change is compared too
+    ASSERT_TRUE(component->getContext()->userUpdateAndRecalculate("a", 20, true));
+    ASSERT_EQ(0, stats.changed);
+    ASSERT_EQ(2, stats.unchanged);  // "big" and the text; the color is never reached
+    ASSERT_TRUE(CheckDirty(root));
+
+    ASSERT_TRUE(component->getContext()->userUpdateAndRecalculate("a", 30, true));
+    ASSERT_EQ(0, stats.changed);
+    ASSERT_EQ(4, stats.unchanged);
+    ASSERT_TRUE(CheckDirty(root));
+
+    ASSERT_TRUE(component->getContext()->userUpdateAndRecalculate("a", 1, true));
+    ASSERT_TRUE(IsEqual("small", component->getCalculated(kPropertyText).asString()));
+    ASSERT_TRUE(IsEqual(Color(Color::BLUE), component->getCalculated(kPropertyColor)));
+    ASSERT_EQ(3, stats.changed);    // "big", the text and the color
+    ASSERT_TRUE(CheckDirty(component, kPropertyText, kPropertyColor,
+                           kPropertyColorKaraokeTarget, kPropertyColorNonKaraoke));
+}
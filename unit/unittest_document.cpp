@@ -22,6 +22,8 @@
 #include "apl/engine/rootcontext.h"
 #include "apl/engine/context.h"
 #include "apl/content/importrequest.h"
+#include "apl/content/jsondata.h"
+#include "apl/content/packagecache.h"
 
 using namespace apl;
 
@@ -60,6 +62,66 @@ TEST(DocumentTest, Load)
     ASSERT_EQ(15000, doc->settings().idleTimeout());
 }
 
+TEST(DocumentTest, LoadInSitu)
+{
+    std::string buffer(BASIC_DOC);
+    JsonData json(&buffer[0]);
+    ASSERT_TRUE(json);
+    ASSERT_EQ(buffer.size(), json.bytesParsed());
+
+    // Strings are decoded into the caller's buffer rather than copied into the document
+    const char *type = json.get()["type"].GetString();
+    ASSERT_TRUE(type >= buffer.data() && type < buffer.data() + buffer.size());
+
+    auto content = Content::create(std::move(json), makeDefaultSession());
+    ASSERT_TRUE(content);
+    content->addData("payload", "\"duck\"");
+    ASSERT_TRUE(content->isReady());
+
+    auto doc = RootContext::create(Metrics().size(1024,800), content);
+    ASSERT_TRUE(doc);
+}
+
+TEST(DocumentTest, LoadFromFile)
+{
+    auto file = std::tmpfile();
+    ASSERT_TRUE(file);
+    std::fputs(BASIC_DOC, file);
+    std::rewind(file);
+
+    JsonData json(file);
+    std::fclose(file);
+    ASSERT_TRUE(json);
+    ASSERT_EQ(std::strlen(BASIC_DOC), json.bytesParsed());
+
+    auto content = Content::create(std::move(json), makeDefaultSession());
+    ASSERT_TRUE(content);
+    content->addData("payload", "\"duck\"");
+    ASSERT_TRUE(content->isReady());
+}
+
+TEST(DocumentTest, ParseStatistics)
+{
+    // A payload large enough that parsing takes a measurable amount of time
+    std::string raw = "[";
+    for (int i = 0 ; i < 10000 ; i++)
+        raw += (i ? "," : "") + std::string(R"({"id": )") + std::to_string(i) + R"(, "name": "Item number )" +
+               std::to_string(i) + R"(", "tags": ["a", "b", "c"]})";
+    raw += "]";
+
+    JsonData json(raw);
+    ASSERT_TRUE(json);
+    ASSERT_EQ(raw.size(), json.bytesParsed());
+    ASSERT_LT(0, json.parseTime());
+    ASSERT_LT(0, json.throughput());
+
+    // Wrapping an existing document does not parse any text
+    JsonData wrapped(json.get());
+    ASSERT_EQ(0, wrapped.bytesParsed());
+    ASSERT_EQ(0, wrapped.parseTime());
+    ASSERT_EQ(0, wrapped.throughput());
+}
+
 const char *BASIC_DOC_NO_TYPE_FIELD =
         "{"
         "  \"version\": \"1.1\","
@@ -880,6 +942,154 @@ TEST(DocumentTest, GenerateChain)
     ASSERT_EQ(Object("B"), context->opt("@testB"));
 }
 
+TEST(DocumentTest, CachedChain)
+{
+    auto m = Metrics().size(1024,800).theme("dark");
+    auto cache = PackageCache::create();
+
+    auto json = makeTestPackage({"A"}, {{"test", "value"}});
+    auto pkg_a = makeTestPackage({"B"}, {{"testA", "A"}});
+    auto pkg_b = makeTestPackage({}, {{"testB", "B"}});
+
+    // The first document loads the packages one level at a time
+    auto content = Content::create(json, makeDefaultSession(), cache);
+    ASSERT_TRUE(content);
+    ASSERT_TRUE(content->isWaiting());
+    auto requested = content->getRequestedPackages();
+    ASSERT_EQ(1, requested.size());
+    content->addPackage(*requested.begin(), pkg_a.c_str());
+    requested = content->getRequestedPackages();
+    ASSERT_EQ(1, requested.size());
+    content->addPackage(*requested.begin(), pkg_b.c_str());
+    ASSERT_TRUE(content->isReady());
+    ASSERT_EQ(2, cache->size());
+
+    // The second document resolves the entire chain from the cache
+    auto content2 = Content::create(json, makeDefaultSession(), cache);
+    ASSERT_TRUE(content2);
+    ASSERT_FALSE(content2->isWaiting());
+    ASSERT_TRUE(content2->isReady());
+    ASSERT_EQ(0, content2->getRequestedPackages().size());
+    ASSERT_EQ(content->getPackage("A"), content2->getPackage("A"));
+    ASSERT_EQ(2, cache->hits());
+
+    auto doc = RootContext::create(m, content2);
+    ASSERT_TRUE(doc);
+    auto context = doc->contextPtr();
+    ASSERT_EQ(Object("value"), context->opt("@test"));
+    ASSERT_EQ(Object("A"), context->opt("@testA"));
+    ASSERT_EQ(Object("B"), context->opt("@testB"));
+
+    // The first document is unaffected by sharing its packages
+    doc = RootContext::create(m, content);
+    ASSERT_TRUE(doc);
+    ASSERT_EQ(3, doc->info().resources().size());
+}
+
+TEST(DocumentTest, CachedPackageOutlivesCallerDocument)
+{
+    auto m = Metrics().size(1024,800).theme("dark");
+    auto cache = PackageCache::create();
+    auto json = makeTestPackage({"A"}, {{"test", "value"}});
+
+    auto content = Content::create(json, makeDefaultSession(), cache);
+    ASSERT_TRUE(content->isWaiting());
+    {
+        // The package references a document owned by the caller, which is freed right away
+        rapidjson::Document pkg;
+        pkg.Parse(makeTestPackage({}, {{"testA", "A"}}).c_str());
+        JsonData data(static_cast<const rapidjson::Value&>(pkg));
+        ASSERT_FALSE(data.ownsData());
+        content->addPackage(*content->getRequestedPackages().begin(), std::move(data));
+    }
+    ASSERT_TRUE(content->isReady());
+    ASSERT_EQ(1, cache->size());
+
+    // The cached copy is independent of the freed document
+    auto content2 = Content::create(json, makeDefaultSession(), cache);
+    ASSERT_TRUE(content2->isReady());
+    ASSERT_EQ(1, cache->hits());
+
+    auto doc = RootContext::create(m, content2);
+    ASSERT_TRUE(doc);
+    ASSERT_EQ(Object("A"), doc->contextPtr()->opt("@testA"));
+}
+
+TEST(DocumentTest, CacheEviction)
+{
+    auto cache = PackageCache::create(2);
+    auto a = Package::create(makeDefaultSession(), "A", makeTestPackage({}, {}));
+    auto b = Package::create(makeDefaultSession(), "B", makeTestPackage({}, {}));
+    auto c = Package::create(makeDefaultSession(), "C", makeTestPackage({}, {}));
+
+    cache->add(ImportRef("A", "1.0"), a);
+    cache->add(ImportRef("B", "1.0"), b);
+    ASSERT_EQ(a, cache->find(ImportRef("A", "1.0")));   // A is now the most recently used
+    ASSERT_EQ(nullptr, cache->find(ImportRef("A", "2.0")));  // Versions are cached separately
+
+    cache->add(ImportRef("C", "1.0"), c);
+    ASSERT_EQ(2, cache->size());
+    ASSERT_EQ(a, cache->find(ImportRef("A", "1.0")));
+    ASSERT_EQ(nullptr, cache->find(ImportRef("B", "1.0")));
+    ASSERT_EQ(c, cache->find(ImportRef("C", "1.0")));
+
+    ASSERT_EQ(3, cache->hits());
+    ASSERT_EQ(2, cache->misses());
+
+    cache->clear();
+    ASSERT_EQ(0, cache->size());
+}
+
+TEST(DocumentTest, CacheEvictsUnusedFirst)
+{
+    auto cache = PackageCache::create(2);
+    auto a = Package::create(makeDefaultSession(), "A", makeTestPackage({}, {}));
+
+    cache->add(ImportRef("A", "1.0"), a);
+    cache->add(ImportRef("B", "1.0"), Package::create(makeDefaultSession(), "B", makeTestPackage({}, {})));
+    cache->add(ImportRef("C", "1.0"), Package::create(makeDefaultSession(), "C", makeTestPackage({}, {})));
+
+    // "A" is the least recently used, but it is still referenced
+    ASSERT_EQ(2, cache->size());
+    ASSERT_EQ(a, cache->find(ImportRef("A", "1.0")));
+    ASSERT_EQ(nullptr, cache->find(ImportRef("B", "1.0")));
+}
+
+TEST(DocumentTest, CacheMemoryBudget)
+{
+    auto json = makeTestPackage({}, {{"test", "value"}});
+    auto cache = PackageCache::create(10, 2 * json.size() + 1);
+
+    for (const char *name : {"A", "B", "C"})
+        cache->add(ImportRef(name, "1.0"), Package::create(makeDefaultSession(), name, json));
+
+    ASSERT_EQ(2, cache->size());
+    ASSERT_EQ(2 * json.size(), cache->memoryUse());
+    ASSERT_EQ(nullptr, cache->find(ImportRef("A", "1.0")));
+}
+
+TEST(DocumentTest, CacheMemoryBudgetFromDocument)
+{
+    // Packages built from an existing rapidjson document have an estimated size
+    auto makePackage = [](const char *name) {
+        rapidjson::Document doc;
+        doc.Parse(makeTestPackage({}, {{"test", "value"}}).c_str());
+        return Package::create(makeDefaultSession(), name, JsonData(std::move(doc)));
+    };
+
+    auto a = makePackage("A");
+    ASSERT_LT(0, a->size());
+
+    auto cache = PackageCache::create(10, 2 * a->size() + 1);
+    cache->add(ImportRef("A", "1.0"), a);
+    cache->add(ImportRef("B", "1.0"), makePackage("B"));
+    a = nullptr;
+    cache->add(ImportRef("C", "1.0"), makePackage("C"));
+
+    ASSERT_EQ(2, cache->size());
+    ASSERT_EQ(nullptr, cache->find(ImportRef("A", "1.0")));
+}
+
 TEST(DocumentTest, Loop)
 {
     auto m = Metrics().size(1024,800).theme("dark");
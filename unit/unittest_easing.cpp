@@ -77,6 +77,56 @@ TEST_F(EasingTest, CubicBezierEase)
     }
 }
 
+static std::vector<std::array<float, 4>> sBezierCurves = {
+    {0.25, 0.10, 0.25, 1.0},    // ease
+    {0.42, 0, 1, 1},            // ease-in
+    {0, 0, 0.58, 1},            // ease-out
+    {0.42, 0, 0.58, 1},         // ease-in-out
+    {0.33, -0.5, 0.92, 0.38},
+    {0.9, 0.1, 0.1, 0.9},
+    {0.1, 0.7, 0.6, 0.9},
+};
+
+TEST_F(EasingTest, CubicBezierAccuracy)
+{
+    for (const auto& c : sBezierCurves) {
+        CubicBezierEasing curve(c[0], c[1], c[2], c[3]);
+
+        for (int i = 0 ; i <= 1000 ; i++) {
+            double alpha = 0.001 * i;
+            float t = f(c[0], c[2], alpha);
+            float v = f(c[1], c[3], alpha);
+            ASSERT_NEAR(v, curve.calc(t), 0.00002) << curve.toDebugString() << " alpha=" << alpha;
+        }
+    }
+}
+
+TEST_F(EasingTest, BatchCalc)
+{
+    std::vector<float> times;
+    for (int i = -2 ; i <= 102 ; i++)
+        times.push_back(0.01 * i);
+
+    std::vector<EasingCurve*> curves = {
+        new LinearEasing(),
+        new PathEasing({0,0, 0.25,1, 0.75,0, 1,1}),
+        new CubicBezierEasing(0.42, 0, 0.58, 1)
+    };
+
+    for (auto curve : curves) {
+        std::vector<float> out(times.size());
+        curve->calc(times.data(), out.data(), times.size());
+        for (size_t i = 0 ; i < times.size() ; i++)
+            ASSERT_EQ(curve->calc(times[i]), out[i]) << curve->toDebugString() << " t=" << times[i];
+
+        // In-place evaluation
+        std::vector<float> inplace(times);
+        Easing(curve).calc(inplace.data(), inplace.data(), inplace.size());
+        ASSERT_EQ(out, inplace);
+        delete curve;
+    }
+}
+
 TEST_F(EasingTest, EasingCurve)
 {
     Easing linear = Easing::parse(session, "");
@@ -358,3 +358,100 @@ TEST_F(FindComponentAtPosition, NonLaidOutSequence)
     ASSERT_EQ(component->getChildAt(1), component->findComponentAtPosition(Point(5, 45)));
     ASSERT_EQ(component->getChildAt(2), component->findComponentAtPosition(Point(5, 85)));
 }
+
+static const char *LONG_SEQUENCE =
+    "{"
+    "  \"type\": \"APL\","
+    "  \"version\": \"1.1\","
+    "  \"mainTemplate\": {"
+    "    \"parameters\": [ \"payload\" ],"
+    "    \"items\": {"
+    "      \"type\": \"Sequence\","
+    "      \"width\": 100,"
+    "      \"height\": 100,"
+    "      \"data\": \"${payload}\","
+    "      \"items\": {"
+    "        \"type\": \"Frame\","
+    "        \"width\": 100,"
+    "        \"height\": 40,"
+    "        \"spacing\": 10,"
+    "        \"display\": \"${data == 5 ? 'none' : 'normal'}\""
+    "      }"
+    "    }"
+    "  }"
+    "}";
+
+TEST_F(FindComponentAtPosition, LongSequence)
+{
+    std::string payload = "[0";
+    for (int i = 1 ; i < 200 ; i++)
+        payload += "," + std::to_string(i);
+    payload += "]";
+
+    loadDocument(LONG_SEQUENCE, payload.c_str());
+    ASSERT_TRUE(component);
+    ASSERT_EQ(200, component->getChildCount());
+
+    // Trimming a long scroll lays out the children needed to reach that position.
+    // The hidden child doesn't take up space, so later children are shifted up by one slot.
+    ASSERT_EQ(Point(0, 5000), component->trimScroll(Point(0, 5000)));
+
+    component->update(kUpdateScrollPosition, 5000);
+    ASSERT_EQ(component->getChildAt(101), component->findComponentAtPosition(Point(5, 5)));
+    ASSERT_EQ(component->getChildAt(101), component->findComponentAtPosition(Point(5, 40)));
+    ASSERT_EQ(component, component->findComponentAtPosition(Point(5, 45)));   // In the spacing
+    ASSERT_EQ(component->getChildAt(102), component->findComponentAtPosition(Point(5, 55)));
+
+    component->update(kUpdateScrollPosition, 0);
+    ASSERT_EQ(component->getChildAt(0), component->findComponentAtPosition(Point(5, 0)));
+    ASSERT_EQ(component->getChildAt(1), component->findComponentAtPosition(Point(5, 50)));
+    ASSERT_EQ(component, component->findComponentAtPosition(Point(5, 95)));
+
+    component->update(kUpdateScrollPosition, 200);
+    ASSERT_EQ(component->getChildAt(4), component->findComponentAtPosition(Point(5, 5)));
+    ASSERT_EQ(component->getChildAt(6), component->findComponentAtPosition(Point(5, 55)));
+
+    // Scrolling past the end stops at the last child
+    ASSERT_EQ(Point(0, 199 * 50 - 10 - 100), component->trimScroll(Point(0, 20000)));
+}
+
+static const char *UNEVEN_SEQUENCE =
+    "{"
+    "  \"type\": \"APL\","
+    "  \"version\": \"1.1\","
+    "  \"mainTemplate\": {"
+    "    \"parameters\": [ \"payload\" ],"
+    "    \"items\": {"
+    "      \"type\": \"Sequence\","
+    "      \"width\": 100,"
+    "      \"height\": 100,"
+    "      \"data\": \"${payload}\","
+    "      \"items\": {"
+    "        \"type\": \"Frame\","
+    "        \"width\": 100,"
+    "        \"height\": \"${data < 100 ? 10 : 100}\""
+    "      }"
+    "    }"
+    "  }"
+    "}";
+
+TEST_F(FindComponentAtPosition, UnevenSequenceEnsure)
+{
+    std::string payload = "[0";
+    for (int i = 1 ; i < 200 ; i++)
+        payload += "," + std::to_string(i);
+    payload += "]";
+
+    loadDocument(UNEVEN_SEQUENCE, payload.c_str());
+    ASSERT_TRUE(component);
+    ASSERT_EQ(200, component->getChildCount());
+
+    // The first 100 children are short, so the average extent underestimates the rest.  The
+    // children ensured in each pass are capped, so we don't lay out every tall child at once.
+    ASSERT_EQ(Point(0, 2000), component->trimScroll(Point(0, 2000)));
+    ASSERT_EQ(Rect(0, 2000, 100, 100), component->getChildAt(110)->getCalculated(kPropertyBounds).getRect());
+    ASSERT_NE(6000, component->getChildAt(150)->getCalculated(kPropertyBounds).getRect().getY());   // Not laid out
+
+    component->update(kUpdateScrollPosition, 2000);
+    ASSERT_EQ(component->getChildAt(110), component->findComponentAtPosition(Point(5, 5)));
+}
@@ -13,7 +13,10 @@
  * permissions and limitations under the License.
  */
 
+#include <cmath>
+
 #include "testeventloop.h"
+#include "apl/graphic/graphicpath.h"
 
 using namespace apl;
 
@@ -694,4 +697,149 @@ TEST_F(GraphicTest, StyledParameters2)
     ASSERT_EQ(1, path->getDirtyProperties().size());
     ASSERT_EQ(1, path->getDirtyProperties().count(kGraphicPropertyFill));
     ASSERT_EQ(Object(Color(Color::OLIVE)), path->getValue(kGraphicPropertyFill));
-}
\ No newline at end of file
+}
+
+TEST_F(GraphicTest, PathParsing)
+{
+    GraphicPath path("M10,10 h20 v20 H10 z m5 5 l5 5");
+    ASSERT_TRUE(path.isValid());
+    ASSERT_EQ(std::vector<GraphicPathCommand>({kGraphicPathCommandMoveTo,
+                                               kGraphicPathCommandLineTo,
+                                               kGraphicPathCommandLineTo,
+                                               kGraphicPathCommandLineTo,
+                                               kGraphicPathCommandClose,
+                                               kGraphicPathCommandMoveTo,
+                                               kGraphicPathCommandLineTo}), path.commands());
+    ASSERT_EQ(std::vector<float>({10, 10, 30, 10, 30, 30, 10, 30, 15, 15, 20, 20}), path.points());
+    ASSERT_EQ(Rect(10, 10, 20, 20), path.bounds());
+
+    // Compact numbers, exponents, and implicit repeated commands
+    GraphicPath compact("M1e1-5.5L1 2 3 4l.5.5");
+    ASSERT_TRUE(compact.isValid());
+    ASSERT_EQ(4, compact.commands().size());
+    ASSERT_EQ(std::vector<float>({10, -5.5, 1, 2, 3, 4, 3.5, 4.5}), compact.points());
+
+    // Errors keep the path parsed so far
+    GraphicPath bad("M0,0 L10,10 X 20,20");
+    ASSERT_FALSE(bad.isValid());
+    ASSERT_EQ(2, bad.commands().size());
+
+    GraphicPath empty("");
+    ASSERT_TRUE(empty.empty());
+    ASSERT_TRUE(empty.bounds().isEmpty());
+}
+
+TEST_F(GraphicTest, PathCurves)
+{
+    // The curve extends well above its end points
+    GraphicPath cubic("M0,0 C0,-40 100,-40 100,0");
+    ASSERT_EQ(kGraphicPathCommandCubicTo, cubic.commands().at(1));
+    ASSERT_NEAR(-30, cubic.bounds().getY(), 0.001);
+    ASSERT_NEAR(30, cubic.bounds().getHeight(), 0.001);
+    ASSERT_NEAR(100, cubic.bounds().getWidth(), 0.001);
+
+    // Smooth curves reflect the previous control point
+    GraphicPath smooth("M0,0 Q10,10 20,0 T40,0");
+    ASSERT_EQ(std::vector<float>({0, 0, 10, 10, 20, 0, 30, -10, 40, 0}), smooth.points());
+    ASSERT_NEAR(-5, smooth.bounds().getY(), 0.001);
+    ASSERT_NEAR(10, smooth.bounds().getHeight(), 0.001);
+
+    // A half circle arc, written with compact flags
+    GraphicPath arc("M0,0 a50 50 0 01100 0");
+    ASSERT_TRUE(arc.isValid());
+    ASSERT_EQ(3, arc.commands().size());
+    ASSERT_NEAR(-50, arc.bounds().getY(), 0.01);
+    ASSERT_NEAR(100, arc.bounds().getWidth(), 0.01);
+    ASSERT_NEAR(100, arc.points().at(arc.points().size() - 2), 0.0001);
+
+    // Flattening stays within the tolerance of the circle
+    auto lines = arc.flatten(0.1f);
+    ASSERT_EQ(1, lines.size());
+    ASSERT_GT(lines[0].size(), 10);
+    for (const auto& p : lines[0]) {
+        auto dx = p.getX() - 50;
+        auto dy = p.getY();
+        ASSERT_NEAR(50, std::sqrt(dx * dx + dy * dy), 0.1);
+    }
+
+    // Coarser tolerances use fewer points
+    ASSERT_LT(arc.flatten(2).at(0).size(), lines[0].size());
+
+    // Closed paths return to their start
+    auto closed = GraphicPath("M0,0 h10 v10 z").flatten(1);
+    ASSERT_EQ(1, closed.size());
+    ASSERT_EQ(4, closed[0].size());
+    ASSERT_EQ(Point(0, 0), closed[0].back());
+
+    // Drawing after a close without a move starts a new sub-path at the start of the closed one
+    auto reopened = GraphicPath("M5,5 h10 v10 z l-5,5 Q0,20 0,15 z").flatten(1);
+    ASSERT_EQ(2, reopened.size());
+    ASSERT_EQ(4, reopened[0].size());
+    ASSERT_EQ(Point(5, 5), reopened[0].back());
+    ASSERT_EQ(Point(5, 5), reopened[1].front());
+    ASSERT_EQ(Point(0, 10), reopened[1].at(1));
+    ASSERT_EQ(Point(5, 5), reopened[1].back());
+}
+
+static const char *STYLED_PATH_DOC =
+    "{"
+    "  \"type\": \"APL\","
+    "  \"version\": \"1.0\","
+    "  \"mainTemplate\": {"
+    "    \"items\": {"
+    "      \"type\": \"Container\""
+    "    }"
+    "  },"
+    "  \"styles\": {"
+    "    \"base\": {"
+    "      \"values\": ["
+    "        {"
+    "          \"shape\": \"M0,0 h10 v10 h-10 z\""
+    "        },"
+    "        {"
+    "          \"shape\": \"M0,0 h50 v20 h-50 z\","
+    "          \"when\": \"${state.disabled}\""
+    "        }"
+    "      ]"
+    "    }"
+    "  },"
+    "  \"graphics\": {"
+    "    \"box\": {"
+    "      \"type\": \"AVG\","
+    "      \"version\": \"1.0\","
+    "      \"height\": 100,"
+    "      \"width\": 100,"
+    "      \"parameters\": [ \"shape\" ],"
+    "      \"items\": {"
+    "        \"type\": \"path\","
+    "        \"pathData\": \"${shape}\""
+    "      }"
+    "    }"
+    "  }"
+    "}";
+
+TEST_F(GraphicTest, PathCached)
+{
+    auto content = Content::create(STYLED_PATH_DOC, session);
+    ASSERT_TRUE(content);
+    auto root = RootContext::create(metrics, content);
+    ASSERT_TRUE(root);
+
+    auto box = root->context().getGraphic("box");
+    loadGraphic(box.json(), root->context().getStyle("base", State()));
+    auto element = graphic->getRoot()->getChildAt(0);
+    ASSERT_FALSE(graphic->getRoot()->getPath());
+
+    auto path = element->getPath();
+    ASSERT_TRUE(path);
+    ASSERT_EQ(Rect(0, 0, 10, 10), path->bounds());
+    ASSERT_EQ(path, element->getPath());  // Not re-parsed
+
+    // Changing the path data replaces the parsed path
+    graphic->updateStyle(root->context().getStyle("base", State().emplace(kStateDisabled)));
+    ASSERT_EQ(1, element->getDirtyProperties().count(kGraphicPropertyPathData));
+    auto path2 = element->getPath();
+    ASSERT_NE(path, path2);
+    ASSERT_EQ(Rect(0, 0, 50, 20), path2->bounds());
+    ASSERT_EQ(path2, element->getPath());
+}
@@ -470,6 +470,74 @@ TEST_F(GraphicComponentTest, StyleTest)
     ASSERT_TRUE(CheckDirty(graphic, path));
 }
 
+TEST_F(GraphicComponentTest, SerializeDirty)
+{
+    loadDocument(GRAPHIC_STYLE);
+
+    auto graphic = component->getCalculated(kPropertyGraphic).getGraphic();
+    auto path = graphic->getRoot()->getChildAt(0);
+    rapidjson::Document doc;
+
+    ASSERT_EQ(0, graphic->serializeDirty(doc.GetAllocator()).Size());
+
+    component->setState(kStatePressed, true);
+    ASSERT_EQ(1, graphic->getDirty().count(path));
+    ASSERT_EQ(1, component->getDirty().count(kPropertyGraphic));
+
+    // The component still sends the full graphic
+    auto json = component->serializeDirty(doc.GetAllocator());
+    ASSERT_TRUE(json.HasMember("graphic"));
+    ASSERT_TRUE(json["graphic"].HasMember("root"));
+
+    // Only the changed element and property are serialized
+    auto changes = graphic->serializeDirty(doc.GetAllocator());
+    ASSERT_EQ(1, changes.Size());
+    ASSERT_EQ(path->getId(), changes[0]["id"].GetUint());
+    ASSERT_EQ(1, changes[0]["props"].MemberCount());
+    ASSERT_TRUE(changes[0]["props"].HasMember("fill"));
+
+    // Serializing does not clear the changes
+    ASSERT_EQ(1, graphic->getDirty().size());
+    ASSERT_EQ(1, path->getDirtyProperties().count(kGraphicPropertyFill));
+
+    graphic->clearDirty();
+    ASSERT_EQ(0, graphic->serializeDirty(doc.GetAllocator()).Size());
+}
+
+TEST_F(GraphicComponentTest, IncrementalSerializeDirty)
+{
+    config.incrementalGraphicUpdates(true);
+    loadDocument(GRAPHIC_STYLE);
+
+    auto graphic = component->getCalculated(kPropertyGraphic).getGraphic();
+    auto path = graphic->getRoot()->getChildAt(0);
+    rapidjson::Document doc;
+
+    component->setState(kStatePressed, true);
+    ASSERT_TRUE(path->getDirtyMask().test(kGraphicPropertyFill));
+    ASSERT_EQ(1, path->getDirtyMask().count());
+    ASSERT_EQ(0, component->getDirty().count(kPropertyGraphic));
+    ASSERT_EQ(1, component->getDirty().count(kPropertyGraphicChanges));
+
+    // Only the changed element and property are sent, and the element flags are cleared
+    auto json = component->serializeDirty(doc.GetAllocator());
+    ASSERT_FALSE(json.HasMember("graphic"));
+    ASSERT_TRUE(json.HasMember("graphicChanges"));
+    ASSERT_EQ(1, json["graphicChanges"].Size());
+    ASSERT_EQ(path->getId(), json["graphicChanges"][0]["id"].GetUint());
+    ASSERT_EQ(1, json["graphicChanges"][0]["props"].MemberCount());
+    ASSERT_TRUE(json["graphicChanges"][0]["props"].HasMember("fill"));
+    ASSERT_EQ(0, graphic->getDirty().size());
+    ASSERT_TRUE(path->getDirtyMask().none());
+    ASSERT_EQ(0, component->getDirty().size());
+
+    // The next change is reported on its own
+    component->setState(kStatePressed, false);
+    json = component->serializeDirty(doc.GetAllocator());
+    ASSERT_EQ(1, json["graphicChanges"].Size());
+    ASSERT_TRUE(IsEqual(Color(session, "blue"), path->getValue(kGraphicPropertyFill)));
+}
+
 
 static const char *GRAPHIC_STYLE_WITH_ALIGNMENT =
     "{"
@@ -626,4 +626,106 @@ TEST_F(KeyboardManagerTest, IntrinsicNotConsumed) {
     ASSERT_FALSE(root->handleKeyboard(kKeyUp, Keyboard::PAGE_DOWN_KEY()));
     ASSERT_FALSE(root->handleKeyboard(kKeyUp, Keyboard::HOME_KEY()));
     ASSERT_FALSE(root->handleKeyboard(kKeyUp, Keyboard::END_KEY()));
-}
\ No newline at end of file
+}
+
+/**
+ * Test that key handlers are parsed into code tests and expressions.
+ */
+TEST_F(KeyboardManagerTest, CompileKeyHandlers) {
+    auto handlers = JsonData(
+        "["
+        "  { \"when\": \"${event.keyboard.code == 'KeyB'}\" },"
+        "  { \"when\": \"${ event.keyboard.code==\\\"KeyG\\\" }\", \"propagate\": true },"
+        "  { \"when\": \"${event.keyboard.code == 'KeyB' && event.keyboard.shift}\" },"
+        "  { \"when\": \"${event.keyboard.key == 'y'}\" },"
+        "  \"not a handler\","
+        "  { \"commands\": [] }"
+        "]");
+    auto context = Context::create(Metrics(), session);
+    auto compiled = KeyboardManager::compileKeyHandlers(*context, Object(handlers.get()).getArray());
+
+    ASSERT_EQ(5, compiled.size());
+    ASSERT_TRUE(compiled[0].codeOnly);
+    ASSERT_EQ("KeyB", compiled[0].code);
+    ASSERT_TRUE(compiled[1].codeOnly);
+    ASSERT_EQ("KeyG", compiled[1].code);
+    ASSERT_TRUE(compiled[1].propagate.asBoolean());
+    ASSERT_FALSE(compiled[2].codeOnly);
+    ASSERT_TRUE(compiled[2].when.isNode());
+    ASSERT_FALSE(compiled[3].codeOnly);
+    ASSERT_FALSE(compiled[4].when.asBoolean());   // A missing "when" never matches
+
+    auto match = [&](const Keyboard& keyboard) -> int {
+        auto eventContext = Context::create(context);
+        auto event = std::make_shared<ObjectMap>();
+        auto kb = keyboard.serialize();
+        event->emplace("keyboard", kb);
+        eventContext->putConstant("event", event);
+        auto handler = KeyboardManager::findKeyHandler(compiled, *eventContext, *kb);
+        return handler ? static_cast<int>(handler - compiled.data()) : -1;
+    };
+
+    ASSERT_EQ(0, match(BLUE_KEY));
+    ASSERT_EQ(0, match(Keyboard("KeyB", "B").shift(true)));  // The first match wins
+    ASSERT_EQ(1, match(GREEN_KEY));
+    ASSERT_EQ(3, match(YELLOW_KEY));
+    ASSERT_EQ(-1, match(NO_KEY));
+}
+
+static const char *BOUND_WHEN_KEY_HANDLER_DOC =
+    "{"
+    "  \"type\": \"APL\","
+    "  \"version\": \"1.1\","
+    "  \"mainTemplate\": {"
+    "    \"item\": {"
+    "      \"type\": \"TouchWrapper\","
+    "      \"bind\": { \"name\": \"armed\", \"value\": false },"
+    "      \"handleKeyDown\": ["
+    "        {"
+    "          \"when\": \"${armed && event.keyboard.code == 'KeyB'}\","
+    "          \"commands\": {"
+    "            \"type\": \"SetValue\","
+    "            \"property\": \"backgroundColor\","
+    "            \"value\": \"blue\","
+    "            \"componentId\": \"testFrame\""
+    "          }"
+    "        },"
+    "        {"
+    "          \"when\": \"${event.keyboard.code == 'KeyG'}\","
+    "          \"commands\": {"
+    "            \"type\": \"SetValue\","
+    "            \"property\": \"armed\","
+    "            \"value\": true"
+    "          }"
+    "        }"
+    "      ],"
+    "      \"item\": {"
+    "        \"type\": \"Frame\","
+    "        \"id\": \"testFrame\","
+    "        \"backgroundColor\": \"red\""
+    "      }"
+    "    }"
+    "  }"
+    "}";
+
+/**
+ * Test that parsed "when" clauses still follow changes to bound values.
+ */
+TEST_F(KeyboardManagerTest, BoundWhen) {
+    loadDocument(BOUND_WHEN_KEY_HANDLER_DOC);
+    ASSERT_TRUE(component);
+    setFocus(component);
+
+    auto target = std::dynamic_pointer_cast<CoreComponent>(root->context().findComponentById("testFrame"));
+    ASSERT_TRUE(target);
+
+    ASSERT_FALSE(root->handleKeyboard(kKeyDown, BLUE_KEY));
+    ASSERT_TRUE(IsEqual(Color(Color::RED), target->getCalculated(kPropertyBackgroundColor)));
+
+    ASSERT_TRUE(root->handleKeyboard(kKeyDown, GREEN_KEY));
+    loop->advanceToEnd();
+
+    ASSERT_TRUE(root->handleKeyboard(kKeyDown, BLUE_KEY));
+    loop->advanceToEnd();
+    ASSERT_TRUE(IsEqual(Color(Color::BLUE), target->getCalculated(kPropertyBackgroundColor)));
+}
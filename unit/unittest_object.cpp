@@ -174,6 +174,43 @@ TEST(ObjectTest, RapidJson)
     ASSERT_FALSE(o6.has("surname"));
 }
 
+TEST(ObjectTest, RapidJsonString)
+{
+    // Strings are copied out of the JSON document, so they remain valid after the document is freed
+    Object name, empty, number;
+    {
+        rapidjson::Document doc;
+        doc.Parse(R"({"name": "Pat", "empty": "", "list": ["Pat", "12.5"]})");
+        Object o(doc);
+
+        name = o.get("name");
+        ASSERT_NE(doc["name"].GetString(), name.getStringData());
+        ASSERT_EQ(name, o.get("list").at(0));
+
+        empty = o.get("empty");
+        number = o.get("list").at(1);
+    }
+
+    ASSERT_TRUE(name.isString());
+    ASSERT_EQ(3, name.size());
+    ASSERT_FALSE(name.empty());
+    ASSERT_TRUE(name.truthy());
+    ASSERT_EQ(std::string("Pat"), name.asString());
+    ASSERT_STREQ("Pat", name.getStringData());
+    ASSERT_EQ(Object("Pat"), name);
+    ASSERT_NE(name, Object("Pa"));
+
+    ASSERT_TRUE(empty.isString());
+    ASSERT_TRUE(empty.empty());
+    ASSERT_FALSE(empty.truthy());
+    ASSERT_EQ(Object(""), empty);
+
+    ASSERT_EQ(12.5, number.asNumber());
+
+    rapidjson::Document out;
+    ASSERT_STREQ("Pat", name.serialize(out.GetAllocator()).GetString());
+}
+
 TEST(ObjectTest, Color)
 {
     Object o = Object(Color(Color::RED));
@@ -13,6 +13,7 @@
  * permissions and limitations under the License.
  */
 
+#include "apl/datagrammar/node.h"
 #include "testeventloop.h"
 
 using namespace apl;
@@ -649,4 +650,120 @@ TEST_F(ParseTest, Compare)
 // TODO: Check symbol
 // TODO: Check field access
 // TODO: Check array access
-// TODO: Check function call
\ No newline at end of file
+// TODO: Check function call
+
+TEST_F(ParseTest, CombineFlattening)
+{
+    context->putUserWriteable("name", "Pat");
+    context->putUserWriteable("count", 3);
+
+    // Nested strings are spliced into a single combine node and adjacent literals are merged
+    auto foo = parseDataBinding(*context, "Hello ${name}${' - ${count} ' + 'items'}${''}!");
+    ASSERT_TRUE(foo.isNode());
+    ASSERT_EQ("Hello Pat - 3 items!", foo.eval(*context).asString());
+
+    foo = parseDataBinding(*context, "Hello ${name}, you have ${'${count} new'} messages${''}");
+    ASSERT_TRUE(foo.isNode());
+    ASSERT_EQ(5, foo.getNode().getArgs().size());   // "Hello ", name, ", you have ", count, " new messages"
+    ASSERT_EQ("Hello Pat, you have 3 new messages", foo.eval(*context).asString());
+
+    // A single node surrounded by empty strings is returned as is
+    foo = parseDataBinding(*context, "${''}${count}${''}");
+    ASSERT_TRUE(foo.isNode());
+    ASSERT_EQ("count", foo.getNode().getArgs().at(0).asString());
+    ASSERT_TRUE(foo.eval(*context).isNumber());
+}
+
+// Count calls so that tests can tell whether an expression was evaluated
+static int sTickCount = 0;
+
+static Object
+tick(const std::vector<Object>& args)
+{
+    sTickCount++;
+    return args.empty() ? Object(true) : args.at(0);
+}
+
+TEST_F(ParseTest, ShortCircuit)
+{
+    context->putUserWriteable("a", 0);
+    context->putUserWriteable("b", "value");
+    context->putUserWriteable("c", Object::NULL_OBJECT());
+
+    ASSERT_TRUE(IsEqual(0, evaluate(*context, "${a && b}")));
+    ASSERT_TRUE(IsEqual("value", evaluate(*context, "${b && b}")));
+    ASSERT_TRUE(IsEqual("value", evaluate(*context, "${a || b}")));
+    ASSERT_TRUE(IsEqual("value", evaluate(*context, "${b || a}")));
+    ASSERT_TRUE(IsEqual("value", evaluate(*context, "${c ?? b}")));
+    ASSERT_TRUE(IsEqual(0, evaluate(*context, "${a ?? b}")));
+
+    // The right-hand side is skipped when the left-hand side decides the result
+    context->putUserWriteable("tick", Object(tick));
+    sTickCount = 0;
+    ASSERT_TRUE(IsEqual(0, evaluate(*context, "${a && tick()}")));
+    ASSERT_TRUE(IsEqual("value", evaluate(*context, "${b || tick()}")));
+    ASSERT_TRUE(IsEqual("value", evaluate(*context, "${b ?? tick()}")));
+    ASSERT_EQ(0, sTickCount);
+
+    // ...and evaluated once when it is needed
+    ASSERT_TRUE(IsEqual(1, evaluate(*context, "${b && tick(1)}")));
+    ASSERT_TRUE(IsEqual(2, evaluate(*context, "${a || tick(2)}")));
+    ASSERT_TRUE(IsEqual(3, evaluate(*context, "${c ?? tick(3)}")));
+    ASSERT_EQ(3, sTickCount);
+
+    // A constant left-hand side reduces the expression to the right-hand side
+    auto foo = parseDataBinding(*context, "${true && b}");
+    ASSERT_TRUE(foo.isNode());
+    ASSERT_EQ("b", foo.getNode().getArgs().at(0).asString());
+    foo = parseDataBinding(*context, "${null ?? b}");
+    ASSERT_TRUE(foo.isNode());
+    ASSERT_EQ("b", foo.getNode().getArgs().at(0).asString());
+}
+
+// Math and String are constants, so a call on constant arguments is made while parsing
+TEST_F(ParseTest, ConstantFunctionCalls)
+{
+    context->putUserWriteable("a", 2);
+
+    auto foo = parseDataBinding(*context, "${Math.min(4, 2.5)}");
+    ASSERT_FALSE(foo.isNode());
+    ASSERT_TRUE(IsEqual(2.5, foo));
+
+    foo = parseDataBinding(*context, "${Math.max(1, Math.abs(-3)) * 2}");
+    ASSERT_FALSE(foo.isNode());
+    ASSERT_TRUE(IsEqual(6, foo));
+
+    foo = parseDataBinding(*context, "${String.toUpperCase('abc') + String.slice('hello', 1, 3)}");
+    ASSERT_FALSE(foo.isNode());
+    ASSERT_TRUE(IsEqual("ABCel", foo));
+
+    // The folded call also collapses the surrounding string
+    foo = parseDataBinding(*context, "Size ${Math.floor(2.7)} of ${String.toLowerCase('TEN')}");
+    ASSERT_FALSE(foo.isNode());
+    ASSERT_TRUE(IsEqual("Size 2 of ten", foo));
+
+    // A call that depends on a writeable value is evaluated later
+    foo = parseDataBinding(*context, "${Math.max(1, a)}");
+    ASSERT_TRUE(foo.isNode());
+    ASSERT_TRUE(IsEqual(2, foo.eval(*context)));
+}
+
+// The parser state is reused between parses; a failed parse must not leak into the next one
+TEST_F(ParseTest, ReuseAfterError)
+{
+    context->putUserWriteable("a", 2);
+
+    auto foo = parseDataBinding(*context, "${Math.min(1, (a + }");
+    ASSERT_TRUE(foo.isString());
+    ASSERT_EQ("${Math.min(1, (a + }", foo.asString());
+
+    foo = parseDataBinding(*context, "${Math.min(10, (a + 1) * 2)} and ${'${a}'}");
+    ASSERT_TRUE(foo.isNode());
+    ASSERT_EQ("6 and 2", foo.eval(*context).asString());
+
+    foo = parseDataBinding(*context, "${[1, 2, a}");
+    ASSERT_TRUE(foo.isString());
+
+    foo = parseDataBinding(*context, "${1 + 2}");
+    ASSERT_TRUE(IsEqual(3, foo));
+}
@@ -482,4 +482,75 @@ TEST_F(StylesTest, ComponentStyling)
 
     ASSERT_EQ(kVectorGraphicAlignBottom, vectorGraphic->getCalculated(kPropertyAlign).asInt());
     ASSERT_EQ(kVectorGraphicScaleBestFill, vectorGraphic->getCalculated(kPropertyScale).asInt());
-}
\ No newline at end of file
+}
+
+static const char *STYLE_TRANSITIONS =
+    "{"
+    "  \"type\": \"APL\","
+    "  \"version\": \"1.1\","
+    "  \"styles\": {"
+    "    \"frameStyle\": {"
+    "      \"values\": ["
+    "        {"
+    "          \"backgroundColor\": \"blue\","
+    "          \"borderWidth\": 2"
+    "        },"
+    "        {"
+    "          \"when\": \"${state.pressed}\","
+    "          \"backgroundColor\": \"red\""
+    "        },"
+    "        {"
+    "          \"when\": \"${state.disabled}\","
+    "          \"borderColor\": \"green\""
+    "        }"
+    "      ]"
+    "    }"
+    "  },"
+    "  \"mainTemplate\": {"
+    "    \"items\": {"
+    "      \"type\": \"Frame\","
+    "      \"style\": \"frameStyle\","
+    "      \"borderWidth\": 5"
+    "    }"
+    "  }"
+    "}";
+
+TEST_F(StylesTest, StyleTransitions)
+{
+    loadDocument(STYLE_TRANSITIONS);
+    ASSERT_TRUE(component);
+
+    // States that evaluate to the same values share a single style instance
+    State state;
+    auto base = context->getStyle("frameStyle", state);
+    state.set(kStateFocused, true);
+    ASSERT_EQ(base, context->getStyle("frameStyle", state));
+    state.set(kStatePressed, true);
+    ASSERT_NE(base, context->getStyle("frameStyle", state));
+
+    ASSERT_EQ(Color(Color::BLUE), component->getCalculated(kPropertyBackgroundColor).getColor());
+    ASSERT_EQ(5, component->getCalculated(kPropertyBorderWidth).asDimension(*context).getValue());
+
+    // Only the changed property is marked dirty
+    component->setState(kStatePressed, true);
+    ASSERT_EQ(Color(Color::RED), component->getCalculated(kPropertyBackgroundColor).getColor());
+    ASSERT_TRUE(CheckDirty(component, kPropertyBackgroundColor));
+    root->clearDirty();
+
+    // Switching to an equivalent style does nothing
+    component->setState(kStateFocused, true);
+    ASSERT_TRUE(CheckDirty(component));
+
+    // A property the new style drops reverts to its default; assigned properties are untouched
+    component->setState(kStatePressed, false);
+    component->setState(kStateDisabled, true);
+    ASSERT_EQ(Color(Color::BLUE), component->getCalculated(kPropertyBackgroundColor).getColor());
+    ASSERT_EQ(Color(Color::GREEN), component->getCalculated(kPropertyBorderColor).getColor());
+    ASSERT_EQ(5, component->getCalculated(kPropertyBorderWidth).asDimension(*context).getValue());
+    ASSERT_TRUE(CheckDirty(component, kPropertyBackgroundColor, kPropertyBorderColor));
+    root->clearDirty();
+
+    component->setState(kStateDisabled, false);
+    ASSERT_EQ(Color(), component->getCalculated(kPropertyBorderColor).getColor());
+    ASSERT_TRUE(CheckDirty(component, kPropertyBorderColor));
+}
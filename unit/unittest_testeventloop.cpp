@@ -183,4 +183,51 @@ TEST_F(EventLoopWrapper, ParallelAnimations)
 
     ASSERT_EQ(10, count);
     ASSERT_EQ(std::vector<int>({10, 10}), timers);
-}
\ No newline at end of file
+}
+
+// Animators may add and clear other animators while the animators are running
+TEST_F(EventLoopWrapper, ModifyAnimatorsWhileRunning)
+{
+    std::vector<int> calls = {0, 0, 0, 0};
+    timeout_id second = 0;
+    bool added = false;
+
+    loop->setAnimator([&](apl_duration_t delta) {
+        calls[0]++;
+        if (delta >= 200 && second) {
+            loop->clearTimeout(second);
+            second = 0;
+        }
+        if (delta >= 300 && !added) {
+            added = true;
+            for (int i = 0 ; i < 20 ; i++)   // Enough to force the animator arrays to grow
+                loop->setAnimator([&](apl_duration_t) { calls[3]++; }, 100);
+        }
+    }, 1000);
+    second = loop->setAnimator([&](apl_duration_t) { calls[1]++; }, 1000);
+    loop->setAnimator([&](apl_duration_t) { calls[2]++; }, 500);
+
+    ASSERT_EQ(3, loop->animatorCount());
+
+    loop->advanceBy(100);
+    ASSERT_EQ(std::vector<int>({1, 1, 1, 0}), calls);
+
+    loop->advanceBy(100);   // The second animator is cleared before it runs
+    ASSERT_EQ(std::vector<int>({2, 1, 2, 0}), calls);
+    ASSERT_EQ(2, loop->animatorCount());
+
+    loop->advanceBy(100);   // New animators don't run until the next tick
+    ASSERT_EQ(std::vector<int>({3, 1, 3, 0}), calls);
+    ASSERT_EQ(22, loop->animatorCount());
+
+    loop->advanceBy(50);
+    ASSERT_EQ(std::vector<int>({4, 1, 4, 20}), calls);
+
+    while (loop->size())
+        loop->advanceBy(100);
+
+    ASSERT_EQ(11, calls[0]);
+    ASSERT_EQ(6, calls[2]);
+    ASSERT_EQ(40, calls[3]);
+    ASSERT_EQ(0, loop->animatorCount());
+}
@@ -2518,4 +2518,43 @@ TEST_F(VisualContextTest, LayoutChange)
     ASSERT_EQ("50x30+0+0:0", child["position"]);
 
     component->release();
-}
\ No newline at end of file
+}
+
+TEST_F(VisualContextTest, Cached)
+{
+    loadDocument(OPACITY_CHANGE, DATA);
+
+    rapidjson::Document document(rapidjson::kObjectType);
+    ASSERT_TRUE(root->isVisualContextDirty());
+    auto context = root->serializeVisualContext(document.GetAllocator());
+    ASSERT_TRUE(context == component->serializeVisualContext(document.GetAllocator()));
+    ASSERT_FALSE(context.HasMember("children"));
+
+    // Nothing changed; the cached copy is returned
+    ASSERT_FALSE(root->isVisualContextDirty());
+    ASSERT_TRUE(context == root->serializeVisualContext(document.GetAllocator()));
+
+    // Clearing the dirty flags doesn't invalidate the visual context
+    root->clearDirty();
+    ASSERT_FALSE(root->isVisualContextDirty());
+
+    // Change opacity
+    component->getCoreChildAt(0)->setProperty(kPropertyOpacity, 1.0);
+    ASSERT_TRUE(root->isVisualContextDirty());
+    context = root->serializeVisualContext(document.GetAllocator());
+    ASSERT_FALSE(root->isVisualContextDirty());
+    ASSERT_EQ(1, context["children"].GetArray().Size());
+    ASSERT_TRUE(context == component->serializeVisualContext(document.GetAllocator()));
+
+    // Setting the same value again is not a change
+    component->getCoreChildAt(0)->setProperty(kPropertyOpacity, 1.0);
+    ASSERT_FALSE(root->isVisualContextDirty());
+
+    // State changes affect the tags
+    component->setState(kStateDisabled, true);
+    ASSERT_TRUE(root->isVisualContextDirty());
+    context = root->serializeVisualContext(document.GetAllocator());
+    ASSERT_TRUE(context["tags"].HasMember("disabled"));
+
+    component->release();
+}